@@ -15,6 +15,8 @@ TIMEOUT_PER_EXEC="90s"
 readonly WORKSPACE_DIR=$(cd $(dirname ${BASH_SOURCE:-${0}})/.. && pwd)
 readonly RANDOM_ID=$(cat /dev/urandom | base64 | tr -dc 'a-zA-Z0-9' | head -c 10)
 readonly TMP_PATH="/tmp/pmwcas_benchmark-$(id -un)-${RANDOM_ID}"
+# the leading columns of each result line that identify a setting
+readonly KEY_COLUMNS="impl,cm,prefetch,preempt,epoch_scope,conflict_ratio,value_mode,block_size,target_num,skew,thread_num"
 
 usage() {
   cat 1>&2 << EOS
@@ -34,6 +36,8 @@ Options:
   -l: Use latency as a criteria (default: false).
   -T: Set a timeout per execution (default: 90s). We provide this option to
       avoid some infinite loops in the "microsoft/pmwcas" implementation.
+      Only timed-out executions are retried, and settings rejected by the
+      benchmark binary are skipped with a message to stderr.
 EOS
   exit 1
 }
@@ -96,39 +100,90 @@ fi
 
 source "${CONFIG_ENV}"
 
+if [ "${MEASURE_THROUGHPUT}" = "f" ] && [ "${WARMUP_COUNT:-0}" -gt 0 -o "${IN_PROCESS_REPEAT:-1}" -gt 1 ]; then
+  echo "In-process repetitions measure only throughput (do not use -l with them)." 1>&2
+  exit 1
+fi
+
+# record the build, the machine, and the configuration for comparing results later
+${BENCH_BIN} \
+  --metadata \
+  --throughput=${MEASURE_THROUGHPUT} \
+  --num_exec ${OPERATION_COUNT} \
+  --arr_cap ${ARRAY_CAPACITY} \
+  --timeout ${TIMEOUT}
+echo "# numa_nodes: ${NUMA_NODES:-all}"
+echo "# keys: ${KEY_COLUMNS}"
+grep -v -e '^\s*#' -e '^\s*$' "${CONFIG_ENV}" | sed 's/^/# config: /'
+
 for IMPL in ${IMPL_CANDIDATES}; do
-  for BLOCK_SIZE in ${BLOCK_SIZE_CANDIDATES}; do
-    for SKEW_PARAMETER in ${SKEW_CANDIDATES}; do
-      for TARGET_NUM in ${TARGET_CANDIDATES}; do
-        if [ "${IMPL}" = "pcas" -a "${TARGET_NUM}" -ne "1" ]; then
-          continue
-        fi
-        for THREAD_NUM in ${THREAD_CANDIDATES}; do
-          for LOOP in `seq ${BENCH_REPEAT_COUNT}`; do
-            TMP_OUTPUT="${TMP_PATH}-output-$(date +%Y%m%d-%H%m%S-%N).csv"
-            while : ; do
-              timeout "${TIMEOUT_PER_EXEC}" \
-                ${BENCH_BIN} \
-                --${IMPL} \
-                --csv \
-                --throughput=${MEASURE_THROUGHPUT} \
-                --num_exec ${OPERATION_COUNT} \
-                --num_thread ${THREAD_NUM} \
-                --skew_parameter ${SKEW_PARAMETER} \
-                --arr-cap ${ARRAY_CAPACITY} \
-                --block-size ${BLOCK_SIZE} \
-                --timeout ${TIMEOUT} \
-                ${PMEM_DIR} \
-                ${TARGET_NUM} \
-                >> "${TMP_OUTPUT}"
-              if [ ${?} -eq 0 ]; then
-                break
-              fi
+  for CM in ${CM_CANDIDATES:-none}; do
+    for PREFETCH in ${PREFETCH_CANDIDATES:-0}; do
+      for PREEMPT in ${PREEMPT_CANDIDATES:-0}; do
+        for EPOCH_SCOPE in ${EPOCH_SCOPE_CANDIDATES:-1}; do
+          for CONFLICT_RATIO in ${CONFLICT_RATIO_CANDIDATES:-0}; do
+            if [ "${CONFLICT_RATIO}" != "0" -a "${CONFLICT_REGION_SIZE:-0}" -eq "0" ]; then
+              echo "Skip a conflict ratio ${CONFLICT_RATIO} without CONFLICT_REGION_SIZE." 1>&2
+              continue
+            fi
+            for VALUE_MODE in ${VALUE_MODE_CANDIDATES:-counter}; do
+              for BLOCK_SIZE in ${BLOCK_SIZE_CANDIDATES}; do
+                for SKEW_PARAMETER in ${SKEW_CANDIDATES}; do
+                  for TARGET_NUM in ${TARGET_CANDIDATES}; do
+                    if [ "${IMPL}" = "pcas" -a "${TARGET_NUM}" -ne "1" ]; then
+                      continue
+                    fi
+                    for THREAD_NUM in ${THREAD_CANDIDATES}; do
+                      for LOOP in `seq ${BENCH_REPEAT_COUNT}`; do
+                        TMP_OUTPUT="${TMP_PATH}-output-$(date +%Y%m%d-%H%m%S-%N).csv"
+                        while : ; do
+                          timeout "${TIMEOUT_PER_EXEC}" \
+                            ${BENCH_BIN} \
+                            --${IMPL} \
+                            --contention_manager ${CM} \
+                            --prefetch_distance ${PREFETCH} \
+                            --preempt_interval ${PREEMPT} \
+                            --preempt_sleep_us ${PREEMPT_SLEEP_US:-0} \
+                            --epoch_scope ${EPOCH_SCOPE} \
+                            --conflict_ratio ${CONFLICT_RATIO} \
+                            --conflict_region ${CONFLICT_REGION_SIZE:-0} \
+                            --value_mode ${VALUE_MODE} \
+                            --csv \
+                            --throughput=${MEASURE_THROUGHPUT} \
+                            --num_exec ${OPERATION_COUNT} \
+                            --num_thread ${THREAD_NUM} \
+                            --skew_parameter ${SKEW_PARAMETER} \
+                            --arr-cap ${ARRAY_CAPACITY} \
+                            --block-size ${BLOCK_SIZE} \
+                            --timeout ${TIMEOUT} \
+                            --warmup ${WARMUP_COUNT:-0} \
+                            --repeat ${IN_PROCESS_REPEAT:-1} \
+                            --ci_threshold ${CI_THRESHOLD:-0} \
+                            ${PMEM_DIR} \
+                            ${TARGET_NUM} \
+                            > "${TMP_OUTPUT}"
+                          EXIT_CODE=${?}
+                          # retry only timed-out executions; other errors are deterministic
+                          if [ ${EXIT_CODE} -ne 124 ]; then
+                            break
+                          fi
+                        done
+                        if [ ${EXIT_CODE} -ne 0 ]; then
+                          echo "Skip an invalid setting: ${IMPL},${CM},${PREFETCH},${PREEMPT},${EPOCH_SCOPE},${CONFLICT_RATIO},${VALUE_MODE},${BLOCK_SIZE},${TARGET_NUM},${SKEW_PARAMETER},${THREAD_NUM}" 1>&2
+                          rm -f "${TMP_OUTPUT}"
+                          break
+                        fi
+                        # metadata lines of each run (e.g., "# persist_mode:") are kept as is
+                        sed \
+                          "/^#/!s/^/${IMPL},${CM},${PREFETCH},${PREEMPT},${EPOCH_SCOPE},${CONFLICT_RATIO},${VALUE_MODE},${BLOCK_SIZE},${TARGET_NUM},${SKEW_PARAMETER},${THREAD_NUM},/g" \
+                          "${TMP_OUTPUT}"
+                        rm -f "${TMP_OUTPUT}"
+                      done
+                    done
+                  done
+                done
+              done
             done
-            sed \
-              "s/^/${IMPL},${BLOCK_SIZE},${TARGET_NUM},${SKEW_PARAMETER},${THREAD_NUM},/g" \
-              "${TMP_OUTPUT}"
-            rm -f "${TMP_OUTPUT}"
           done
         done
       done
@@ -0,0 +1,147 @@
+#!/bin/bash
+
+set -u
+
+################################################################################
+# Documents
+################################################################################
+
+BENCH_BIN=""
+CONFIG_ENV=""
+PMEM_DIR=""
+NUMA_NODES=""
+MEASURE_THROUGHPUT="t"
+TIMEOUT_PER_EXEC="90s"
+readonly WORKSPACE_DIR=$(cd $(dirname ${BASH_SOURCE:-${0}})/.. && pwd)
+readonly RANDOM_ID=$(cat /dev/urandom | base64 | tr -dc 'a-zA-Z0-9' | head -c 10)
+readonly TMP_PATH="/tmp/pmwcas_queue_benchmark-$(id -un)-${RANDOM_ID}"
+
+usage() {
+  cat 1>&2 << EOS
+Usage:
+  ${BASH_SOURCE:-${0}} <bench_bin> <config> <pmem_dir> 1> results.csv 2> error.log
+Description:
+  Run benchmark to measure throughput/latency of persistent queues with various
+  numbers of producers and consumers. All the benchmark results are output in
+  CSV format.
+Arguments:
+  <bench_bin>: A path to a binary file for benchmarking.
+  <config>: A path to a configuration file for benchmarking.
+  <pmem_dir> : A path to a directory on persistent memory.
+Options:
+  -h: Show this messsage and exit.
+  -n: Only execute benchmark on the CPUs of nodes. See "man numactl" for details.
+  -t: Use throughput as a criteria (default: true).
+  -l: Use latency as a criteria (default: false).
+  -T: Set a timeout per execution (default: 90s). Only timed-out executions
+      are retried, and settings rejected by the benchmark binary are skipped
+      with a message to stderr.
+EOS
+  exit 1
+}
+
+################################################################################
+# Parse options
+################################################################################
+
+while getopts n:lhtT: OPT
+do
+  case ${OPT} in
+    n) NUMA_NODES=${OPTARG}
+      ;;
+    t) MEASURE_THROUGHPUT="t"
+      ;;
+    l) MEASURE_THROUGHPUT="f"
+      ;;
+    T) TIMEOUT_PER_EXEC=${OPTARG}
+      ;;
+    h) usage
+      ;;
+    \?) usage
+      ;;
+  esac
+done
+shift $((${OPTIND} - 1))
+
+################################################################################
+# Parse arguments
+################################################################################
+
+if [ ${#} != 3 ]; then
+  usage
+fi
+
+BENCH_BIN=${1}
+CONFIG_ENV=${2}
+PMEM_DIR=${3}
+
+if [ ! -f "${BENCH_BIN}" ]; then
+  echo "There is no specified benchmark binary."
+  exit 1
+fi
+if [ ! -f "${CONFIG_ENV}" ]; then
+  echo "There is no specified configuration file."
+  exit 1
+fi
+if [ ! -d "${PMEM_DIR}" ]; then
+  echo "There is no specified directory."
+  exit 1
+fi
+
+if [ -n "${NUMA_NODES}" ]; then
+  BENCH_BIN="numactl -N ${NUMA_NODES} -m ${NUMA_NODES} ${BENCH_BIN}"
+fi
+
+################################################################################
+# Run benchmark
+################################################################################
+
+source "${CONFIG_ENV}"
+
+for IMPL in ${IMPL_CANDIDATES}; do
+  for CM in ${CM_CANDIDATES:-none}; do
+    for CAPACITY in ${CAPACITY_CANDIDATES}; do
+      for THREAD_NUM in ${THREAD_CANDIDATES}; do
+        for PRODUCER_NUM in ${PRODUCER_CANDIDATES}; do
+          # the remaining workers are consumers
+          if [ "${PRODUCER_NUM}" -gt "${THREAD_NUM}" ]; then
+            continue
+          fi
+          for LOOP in `seq ${BENCH_REPEAT_COUNT}`; do
+            TMP_OUTPUT="${TMP_PATH}-output-$(date +%Y%m%d-%H%m%S-%N).csv"
+            while : ; do
+              timeout "${TIMEOUT_PER_EXEC}" \
+                ${BENCH_BIN} \
+                --${IMPL} \
+                --contention_manager ${CM} \
+                --csv \
+                --throughput=${MEASURE_THROUGHPUT} \
+                --num_exec ${OPERATION_COUNT} \
+                --num_thread ${THREAD_NUM} \
+                --num_producer ${PRODUCER_NUM} \
+                --capacity ${CAPACITY} \
+                --prefill $((${CAPACITY} / 2)) \
+                --timeout ${TIMEOUT} \
+                ${PMEM_DIR} \
+                > "${TMP_OUTPUT}"
+              EXIT_CODE=${?}
+              # retry only timed-out executions; other errors are deterministic
+              if [ ${EXIT_CODE} -ne 124 ]; then
+                break
+              fi
+            done
+            if [ ${EXIT_CODE} -ne 0 ]; then
+              echo "Skip an invalid setting: ${IMPL},${CM},${CAPACITY},${THREAD_NUM},${PRODUCER_NUM}" 1>&2
+              rm -f "${TMP_OUTPUT}"
+              break
+            fi
+            sed \
+              "s/^/${IMPL},${CM},${CAPACITY},${THREAD_NUM},${PRODUCER_NUM},/g" \
+              "${TMP_OUTPUT}"
+            rm -f "${TMP_OUTPUT}"
+          done
+        done
+      done
+    done
+  done
+done
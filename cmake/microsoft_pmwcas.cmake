@@ -4,10 +4,11 @@ find_package(PkgConfig)
 pkg_check_modules(LIBPMEMOBJ REQUIRED libpmemobj)
 
 # prepare source files
+set(MICROSOFT_PMWCAS_GIT_TAG "3c50dec9cfbe31e3c4b02ef7e0ffd9f0a210adc3") # latest at Feb. 23, 2024
 FetchContent_Declare(
   microsoft_pmwcas
   GIT_REPOSITORY "https://github.com/microsoft/pmwcas.git"
-  GIT_TAG "3c50dec9cfbe31e3c4b02ef7e0ffd9f0a210adc3" # latest at Feb. 23, 2024
+  GIT_TAG "${MICROSOFT_PMWCAS_GIT_TAG}"
 )
 FetchContent_Populate(microsoft_pmwcas)
 set(MICROSOFT_PMWCAS_SOURCES
@@ -53,3 +54,50 @@ target_link_libraries(microsoft_pmwcas PUBLIC
   numa
   ${LIBPMEMOBJ_LIBRARIES}
 )
+
+# build a distinct library with hooks for emulating PMEM latency
+#
+# Only the main benchmark links the interposer of libpmem and has options for
+# emulation, so the other binaries keep using the unmodified library above. The
+# flush/fence instructions are replaced in a copy of "util/nvram.h", which
+# shadows the original one through the include path.
+if(${PMWCAS_BENCH_EMULATE_PMEM})
+  set(MICROSOFT_PMWCAS_OVERLAY_DIR "${CMAKE_CURRENT_BINARY_DIR}/microsoft_pmwcas_emulated")
+  file(READ "${microsoft_pmwcas_SOURCE_DIR}/src/util/nvram.h" MICROSOFT_PMWCAS_NVRAM)
+  string(REPLACE "_mm_clflushopt(" "::EmulatedClflushopt(" MICROSOFT_PMWCAS_NVRAM "${MICROSOFT_PMWCAS_NVRAM}")
+  string(REPLACE "_mm_clflush(" "::EmulatedClflush(" MICROSOFT_PMWCAS_NVRAM "${MICROSOFT_PMWCAS_NVRAM}")
+  string(REPLACE "_mm_clwb(" "::EmulatedClwb(" MICROSOFT_PMWCAS_NVRAM "${MICROSOFT_PMWCAS_NVRAM}")
+  string(REPLACE "_mm_sfence(" "::EmulatedSfence(" MICROSOFT_PMWCAS_NVRAM "${MICROSOFT_PMWCAS_NVRAM}")
+  file(WRITE "${MICROSOFT_PMWCAS_OVERLAY_DIR}/util/nvram.h" "${MICROSOFT_PMWCAS_NVRAM}")
+
+  add_library(microsoft_pmwcas_emulated STATIC ${MICROSOFT_PMWCAS_SOURCES})
+  add_library(microsoft::pmwcas_emulated ALIAS microsoft_pmwcas_emulated)
+  target_include_directories(microsoft_pmwcas_emulated BEFORE PUBLIC
+    "${MICROSOFT_PMWCAS_OVERLAY_DIR}"
+  )
+  target_compile_options(microsoft_pmwcas_emulated PUBLIC
+    "SHELL:-include ${PROJECT_SOURCE_DIR}/include/pmem_emulator.hpp"
+  )
+  target_compile_features(microsoft_pmwcas_emulated PUBLIC
+    "cxx_std_11"
+  )
+  target_include_directories(microsoft_pmwcas_emulated PUBLIC
+    "${microsoft_pmwcas_SOURCE_DIR}/"
+    "${microsoft_pmwcas_SOURCE_DIR}/src"
+    "${microsoft_pmwcas_SOURCE_DIR}/include"
+    "${LIBPMEMOBJ_INCLUDE_DIRS}"
+  )
+  target_compile_definitions(microsoft_pmwcas_emulated PUBLIC
+    DESC_CAP=${PMWCAS_BENCH_MAX_TARGET_NUM}
+    PMEM
+    PMDK
+  )
+  target_link_libraries(microsoft_pmwcas_emulated PUBLIC
+    Threads::Threads
+    rt
+    numa
+    ${LIBPMEMOBJ_LIBRARIES}
+  )
+else()
+  add_library(microsoft::pmwcas_emulated ALIAS microsoft_pmwcas)
+endif()
@@ -0,0 +1,44 @@
+# build our PMwCAS with dirty flags as a distinct library
+#
+# Both variants share the same sources, so the namespace of the dirty-flag variant
+# is renamed from "dbgroup" to "dbgroup_dirty" by the preprocessor. This allows
+# us to link both the variants into a single binary without ODR violations.
+get_target_property(PMEM_ATOMIC_TARGET dbgroup::pmem_atomic ALIASED_TARGET)
+if(NOT PMEM_ATOMIC_TARGET)
+  set(PMEM_ATOMIC_TARGET dbgroup::pmem_atomic)
+endif()
+get_target_property(PMEM_ATOMIC_TYPE ${PMEM_ATOMIC_TARGET} TYPE)
+
+if(PMEM_ATOMIC_TYPE STREQUAL "INTERFACE_LIBRARY")
+  add_library(pmem_atomic_dirty INTERFACE)
+  target_link_libraries(pmem_atomic_dirty INTERFACE
+    ${PMEM_ATOMIC_TARGET}
+  )
+  set(PMEM_ATOMIC_DIRTY_SCOPE INTERFACE)
+else()
+  get_target_property(PMEM_ATOMIC_SOURCE_DIR ${PMEM_ATOMIC_TARGET} SOURCE_DIR)
+  get_target_property(PMEM_ATOMIC_SOURCES ${PMEM_ATOMIC_TARGET} SOURCES)
+  get_target_property(PMEM_ATOMIC_INCLUDES ${PMEM_ATOMIC_TARGET} INCLUDE_DIRECTORIES)
+  get_target_property(PMEM_ATOMIC_LIBS ${PMEM_ATOMIC_TARGET} LINK_LIBRARIES)
+  list(TRANSFORM PMEM_ATOMIC_SOURCES PREPEND "${PMEM_ATOMIC_SOURCE_DIR}/" REGEX "^[^/]")
+
+  add_library(pmem_atomic_dirty STATIC ${PMEM_ATOMIC_SOURCES})
+  target_compile_features(pmem_atomic_dirty PUBLIC
+    "cxx_std_17"
+  )
+  target_include_directories(pmem_atomic_dirty PUBLIC
+    ${PMEM_ATOMIC_INCLUDES}
+  )
+  if(PMEM_ATOMIC_LIBS)
+    target_link_libraries(pmem_atomic_dirty PUBLIC
+      ${PMEM_ATOMIC_LIBS}
+    )
+  endif()
+  set(PMEM_ATOMIC_DIRTY_SCOPE PUBLIC)
+endif()
+
+add_library(dbgroup::pmem_atomic_dirty ALIAS pmem_atomic_dirty)
+target_compile_definitions(pmem_atomic_dirty ${PMEM_ATOMIC_DIRTY_SCOPE}
+  PMEM_ATOMIC_USE_DIRTY_FLAG
+  dbgroup=dbgroup_dirty
+)
@@ -19,9 +19,35 @@
 
 // C++ standard libraries
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
 #include <string>
 
+/*##############################################################################
+ * Global constants
+ *############################################################################*/
+
+#ifdef PMWCAS_BENCH_MAX_TARGET_NUM
+/// @brief The maximum number of target words of PMwCAS.
+constexpr size_t kMaxTargetNum = PMWCAS_BENCH_MAX_TARGET_NUM;
+#else
+/// @brief The maximum number of target words of PMwCAS.
+constexpr size_t kMaxTargetNum = 8;
+#endif
+
+/// @brief The expected size of CPU cache lines.
+constexpr size_t kCacheLineSize = 64;
+
+/// @brief The size of each target word.
+constexpr size_t kWordSize = sizeof(uint64_t);
+
+/// @brief The initial balance of each account in transfer workloads.
+constexpr uint64_t kInitialBalance = 1UL << 32UL;
+
+/// @brief The maximum amount of money moved by each transfer.
+constexpr uint64_t kMaxTransferAmount = 1UL << 10UL;
+
 /*##############################################################################
  * Global utilities
  *############################################################################*/
@@ -53,4 +79,42 @@ GetPath(  //
   return pmem_dir_path.append(layout).native();
 }
 
+/**
+ * @param key A field name in "/proc/self/status" (e.g., "VmRSS").
+ * @return The memory size of a given field in bytes (zero if not found).
+ */
+inline auto
+GetProcStatusSize(  //
+    const std::string &key)  //
+    -> size_t
+{
+  std::ifstream status{"/proc/self/status"};
+  const auto &prefix = key + ":";
+  std::string line{};
+  while (std::getline(status, line)) {
+    if (line.compare(0, prefix.size(), prefix) != 0) continue;
+    return std::stoull(line.substr(prefix.size())) * 1024;  // kB to bytes
+  }
+  return 0;
+}
+
+/**
+ * @return The model name of the first CPU in "/proc/cpuinfo" (empty if not found).
+ */
+inline auto
+GetCPUModel()  //
+    -> std::string
+{
+  std::ifstream cpuinfo{"/proc/cpuinfo"};
+  constexpr char kPrefix[] = "model name";
+  std::string line{};
+  while (std::getline(cpuinfo, line)) {
+    if (line.compare(0, sizeof(kPrefix) - 1, kPrefix) != 0) continue;
+    const auto pos = line.find(':');
+    if (pos == std::string::npos || pos + 2 > line.size()) break;
+    return line.substr(pos + 2);
+  }
+  return "";
+}
+
 #endif  // PMWCAS_BENCHMARK_COMMON_HPP
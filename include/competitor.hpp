@@ -17,12 +17,28 @@
 #ifndef PMWCAS_BENCHMARK_COMPETITOR_HPP
 #define PMWCAS_BENCHMARK_COMPETITOR_HPP
 
+// C++ standard libraries
+#include <cstdint>
+
 // our PMwCAS
 #include "pmem/atomic/descriptor_pool.hpp"
 
 // microsoft/pmwcas
 #include "mwcas/mwcas.h"
 
+// a blocking baseline
+#include "striped_locks.hpp"
+
+/*##############################################################################
+ * Forward declarations
+ *############################################################################*/
+
+namespace dbgroup_dirty::pmem::atomic
+{
+/// @brief Our PMwCAS built with dirty flags (see cmake/pmem_atomic_dirty.cmake).
+class DescriptorPool;
+}  // namespace dbgroup_dirty::pmem::atomic
+
 /*##############################################################################
  * Type aliases for competitors
  *############################################################################*/
@@ -30,10 +46,50 @@
 /// @brief An alias for our PMwCAS.
 using PMwCAS = ::dbgroup::pmem::atomic::DescriptorPool;
 
+/// @brief An alias for our PMwCAS with dirty flags.
+using PMwCASDirty = ::dbgroup_dirty::pmem::atomic::DescriptorPool;
+
 /// @brief An alias for microsoft/pmwcas.
 using MicrosoftPMwCAS = ::pmwcas::DescriptorPool;
 
 /// @brief A dummy alias for software PCAS.
 using PCAS = char;
 
+/// @brief An alias for a blocking baseline with striped spinlocks.
+using LockMwCAS = StripedLocks;
+
+/// @brief A dummy competitor that only decodes operations to measure the harness.
+struct NullPMwCAS {
+};
+
+/*##############################################################################
+ * Bits of target words reserved by competitors
+ *############################################################################*/
+
+/// @brief The bits of target words that a competitor uses for tagging descriptors.
+template <class Implementation>
+inline constexpr uint64_t kReservedBits = 0;
+
+#ifdef PMWCAS_BENCH_DIRTY_VARIANT
+/// @brief Our PMwCAS uses the MSB for descriptors and the next bit for dirty flags.
+template <>
+inline constexpr uint64_t kReservedBits<PMwCAS> = 0b11UL << 62UL;
+#else
+/// @brief Our PMwCAS uses the MSB for descriptors.
+template <>
+inline constexpr uint64_t kReservedBits<PMwCAS> = 1UL << 63UL;
+
+/// @brief Our PMwCAS uses the MSB for descriptors and the next bit for dirty flags.
+template <>
+inline constexpr uint64_t kReservedBits<PMwCASDirty> = 0b11UL << 62UL;
+
+/// @brief microsoft/pmwcas uses three MSBs for MwCAS, RDCSS, and dirty flags.
+template <>
+inline constexpr uint64_t kReservedBits<MicrosoftPMwCAS> = 0b111UL << 61UL;
+
+/// @brief PCAS shares the loads of our PMwCAS, which check the MSB.
+template <>
+inline constexpr uint64_t kReservedBits<PCAS> = 1UL << 63UL;
+#endif
+
 #endif  // PMWCAS_BENCHMARK_COMPETITOR_HPP
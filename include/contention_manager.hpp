@@ -0,0 +1,203 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMWCAS_BENCHMARK_CONTENTION_MANAGER_HPP
+#define PMWCAS_BENCHMARK_CONTENTION_MANAGER_HPP
+
+// C++ standard libraries
+#include <cstddef>
+#include <cstdint>
+
+// system headers
+#include <immintrin.h>
+
+/**
+ * @brief A list of policies for dealing with failed PMwCAS attempts.
+ *
+ */
+enum ContentionPolicy {
+  /// @brief Retry immediately.
+  kNoBackoff,
+  /// @brief Wait for a window that is doubled on each failure.
+  kExponentialBackoff,
+  /// @brief Wait for a random time within an exponentially growing window.
+  kRandomizedBackoff,
+  /// @brief Wait only when the recent failure rate is high.
+  kAdaptiveBackoff,
+};
+
+/**
+ * @brief A per-worker manager for waiting before retrying failed attempts.
+ *
+ */
+class ContentionManager
+{
+ public:
+  /*############################################################################
+   * Public constants
+   *##########################################################################*/
+
+  /// @brief The maximum window size in the binary logarithm of PAUSE counts.
+  static constexpr size_t kMaxWindowShift = 10;
+
+  /// @brief The resolution of failure rates in fixed-point arithmetic.
+  static constexpr uint64_t kRateOne = 1UL << kMaxWindowShift;
+
+  /// @brief Adaptive backoff begins when a failure rate exceeds this value.
+  static constexpr uint64_t kAdaptiveThreshold = kRateOne / 4;
+
+  /*############################################################################
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Construct a new ContentionManager object.
+   *
+   * @param policy A policy for failed attempts.
+   * @param seed A seed value for randomized waiting.
+   */
+  constexpr explicit ContentionManager(  //
+      const ContentionPolicy policy = kNoBackoff,
+      const uint64_t seed = 0)
+      : policy_{policy}, rand_state_{seed | 1UL}
+  {
+  }
+
+  constexpr ContentionManager(const ContentionManager &) = default;
+  constexpr ContentionManager(ContentionManager &&) = default;
+
+  constexpr ContentionManager &operator=(const ContentionManager &obj) = default;
+  constexpr ContentionManager &operator=(ContentionManager &&) = default;
+
+  /*############################################################################
+   * Public destructors
+   *##########################################################################*/
+
+  ~ContentionManager() = default;
+
+  /*############################################################################
+   * Public utilities
+   *##########################################################################*/
+
+  /**
+   * @brief Wait before retrying a failed attempt according to the policy.
+   *
+   * @return The number of executed PAUSE instructions.
+   */
+  auto
+  Backoff()  //
+      -> size_t
+  {
+    ++fail_num_;
+
+    size_t wait = 0;
+    switch (policy_) {
+      case kExponentialBackoff:
+        wait = 1UL << shift_;
+        break;
+      case kRandomizedBackoff:
+        wait = NextRandom() & ((1UL << shift_) - 1);
+        break;
+      case kAdaptiveBackoff:
+        // the window is proportional to the failure rate
+        rate_ += (kRateOne - rate_) >> 3UL;
+        if (rate_ > kAdaptiveThreshold) {
+          wait = NextRandom() % (rate_ + 1);
+        }
+        break;
+      case kNoBackoff:
+      default:
+        return 0;
+    }
+    if (shift_ < kMaxWindowShift) ++shift_;
+
+    for (size_t i = 0; i < wait; ++i) {
+      _mm_pause();
+    }
+    return wait;
+  }
+
+  /**
+   * @brief Reset the backoff window after an operation has completed.
+   *
+   */
+  constexpr void
+  Succeed()
+  {
+    fail_num_ = 0;
+    shift_ = 1;
+    rate_ -= rate_ >> 3UL;
+  }
+
+  /**
+   * @return The number of failed attempts since the last completed operation.
+   */
+  [[nodiscard]] constexpr auto
+  GetFailureNum() const  //
+      -> size_t
+  {
+    return fail_num_;
+  }
+
+  /**
+   * @return The recent failure rate in units of `1 / kRateOne`.
+   */
+  [[nodiscard]] constexpr auto
+  GetFailureRate() const  //
+      -> uint64_t
+  {
+    return rate_;
+  }
+
+ private:
+  /*############################################################################
+   * Internal utilities
+   *##########################################################################*/
+
+  /**
+   * @return A pseudo random value generated by xorshift64.
+   */
+  constexpr auto
+  NextRandom()  //
+      -> uint64_t
+  {
+    rand_state_ ^= rand_state_ << 13UL;
+    rand_state_ ^= rand_state_ >> 7UL;
+    rand_state_ ^= rand_state_ << 17UL;
+    return rand_state_;
+  }
+
+  /*############################################################################
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief A policy for failed attempts.
+  ContentionPolicy policy_{kNoBackoff};
+
+  /// @brief The current window size in the binary logarithm of PAUSE counts.
+  size_t shift_{1};
+
+  /// @brief The recent failure rate (an exponential moving average).
+  uint64_t rate_{0};
+
+  /// @brief The number of failed attempts since the last completed operation.
+  size_t fail_num_{0};
+
+  /// @brief The state of a random value generator.
+  uint64_t rand_state_{1};
+};
+
+#endif  // PMWCAS_BENCHMARK_CONTENTION_MANAGER_HPP
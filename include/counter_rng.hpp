@@ -0,0 +1,136 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMWCAS_BENCHMARK_COUNTER_RNG_HPP
+#define PMWCAS_BENCHMARK_COUNTER_RNG_HPP
+
+// C++ standard libraries
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief A splittable counter-based random engine.
+ *
+ * The i-th value of a stream is a hash (the finalizer of SplitMix64) of a key
+ * and a counter i, so any stream can be created from a seed and a stream ID
+ * in constant time without generating preceding values. This lets threads
+ * generate disjoint parts of a workload in any order with the same results.
+ * This class satisfies the requirements of UniformRandomBitGenerator.
+ */
+class CounterRNG
+{
+ public:
+  /*############################################################################
+   * Type aliases
+   *##########################################################################*/
+
+  using result_type = uint64_t;
+
+  /*############################################################################
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Construct a new CounterRNG object.
+   *
+   * @param seed A seed value shared among streams.
+   * @param stream The ID of an independent stream.
+   */
+  constexpr CounterRNG(  //
+      const uint64_t seed,
+      const uint64_t stream = 0)
+      : key_{Mix(Mix(seed) + (stream + 1) * kGamma)}
+  {
+  }
+
+  /*############################################################################
+   * Public utilities
+   *##########################################################################*/
+
+  static constexpr auto
+  min()  //
+      -> result_type
+  {
+    return std::numeric_limits<result_type>::min();
+  }
+
+  static constexpr auto
+  max()  //
+      -> result_type
+  {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  /**
+   * @return The next random value of this stream.
+   */
+  constexpr auto
+  operator()()  //
+      -> result_type
+  {
+    return Mix(key_ + (++counter_) * kGamma);
+  }
+
+  /**
+   * @param stream The ID of a sub-stream.
+   * @return An independent stream derived from this one.
+   */
+  [[nodiscard]] constexpr auto
+  Split(                            //
+      const uint64_t stream) const  //
+      -> CounterRNG
+  {
+    return CounterRNG{key_, stream};
+  }
+
+ private:
+  /*############################################################################
+   * Internal constants
+   *##########################################################################*/
+
+  /// @brief An odd constant derived from the golden ratio.
+  static constexpr uint64_t kGamma = 0x9E3779B97F4A7C15UL;
+
+  /*############################################################################
+   * Internal utilities
+   *##########################################################################*/
+
+  /**
+   * @param z A value to be mixed.
+   * @return A hash value with good avalanche properties.
+   */
+  static constexpr auto
+  Mix(             //
+      uint64_t z)  //
+      -> uint64_t
+  {
+    z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9UL;
+    z = (z ^ (z >> 27U)) * 0x94D049BB133111EBUL;
+    return z ^ (z >> 31U);
+  }
+
+  /*############################################################################
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief A key unique to this stream.
+  uint64_t key_{0};
+
+  /// @brief The number of generated values.
+  uint64_t counter_{0};
+};
+
+#endif  // PMWCAS_BENCHMARK_COUNTER_RNG_HPP
@@ -0,0 +1,184 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMWCAS_BENCHMARK_LATENCY_HISTOGRAM_HPP
+#define PMWCAS_BENCHMARK_LATENCY_HISTOGRAM_HPP
+
+// C++ standard libraries
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief A compact log-linear histogram of latency.
+ *
+ * Values are grouped by powers of two, and each group is split into
+ * `kSubBucketNum` linear sub-buckets, so the relative error of each bucket is
+ * at most `1 / kSubBucketNum`.
+ *
+ * @tparam kSubBucketBits The binary logarithm of sub-buckets in each power of two.
+ */
+template <size_t kSubBucketBits>
+class LogLinearHistogram
+{
+ public:
+  /*############################################################################
+   * Public constants
+   *##########################################################################*/
+
+  /// @brief The number of sub-buckets in each power of two.
+  static constexpr size_t kSubBucketNum = 1UL << kSubBucketBits;
+
+  /// @brief Values of `2^kMaxBits` or more are counted in the last bucket.
+  static constexpr size_t kMaxBits = 40;
+
+  /// @brief The number of buckets.
+  static constexpr size_t kBucketNum = (kMaxBits - kSubBucketBits + 1) * kSubBucketNum;
+
+  /*############################################################################
+   * Public utilities
+   *##########################################################################*/
+
+  /**
+   * @brief Count a value.
+   *
+   * @param val A value to be recorded.
+   */
+  constexpr void
+  Record(  //
+      const uint64_t val)
+  {
+    ++counts_[GetIndex(val)];
+    ++total_;
+  }
+
+  /**
+   * @brief Add the counts of another histogram.
+   *
+   * @param other A histogram to be merged.
+   */
+  constexpr void
+  Merge(  //
+      const LogLinearHistogram &other)
+  {
+    for (size_t i = 0; i < kBucketNum; ++i) {
+      counts_[i] += other.counts_[i];
+    }
+    total_ += other.total_;
+  }
+
+  /**
+   * @brief Add the counts of another histogram with atomic instructions.
+   *
+   * Multiple threads can merge their own histograms into this one concurrently
+   * without locks.
+   *
+   * @param other A histogram to be merged.
+   */
+  void
+  MergeAtomically(  //
+      const LogLinearHistogram &other)
+  {
+    for (size_t i = 0; i < kBucketNum; ++i) {
+      if (other.counts_[i] == 0) continue;
+      __atomic_fetch_add(&counts_[i], other.counts_[i], __ATOMIC_RELAXED);
+    }
+    __atomic_fetch_add(&total_, other.total_, __ATOMIC_RELEASE);
+  }
+
+  /**
+   * @return The number of recorded values.
+   */
+  [[nodiscard]] constexpr auto
+  GetCount() const  //
+      -> uint64_t
+  {
+    return total_;
+  }
+
+  /**
+   * @param p A percentile in [0, 1].
+   * @return The upper bound of a bucket containing the given percentile.
+   */
+  [[nodiscard]] auto
+  GetPercentile(             //
+      const double p) const  //
+      -> uint64_t
+  {
+    if (total_ == 0) return 0;
+
+    const auto rank = static_cast<uint64_t>(std::ceil(p * total_));
+    uint64_t sum = 0;
+    for (size_t i = 0; i < kBucketNum; ++i) {
+      sum += counts_[i];
+      if (sum >= rank && sum > 0) return GetUpperBound(i);
+    }
+    return GetUpperBound(kBucketNum - 1);
+  }
+
+  /**
+   * @param val A value.
+   * @return The index of a bucket for the value.
+   */
+  static constexpr auto
+  GetIndex(                //
+      const uint64_t val)  //
+      -> size_t
+  {
+    if (val < kSubBucketNum) return val;
+    if (val >> kMaxBits) return kBucketNum - 1;
+
+    const size_t msb = 63 - __builtin_clzll(val);
+    const auto shift = msb - kSubBucketBits;
+    return (shift + 1) * kSubBucketNum + ((val >> shift) - kSubBucketNum);
+  }
+
+  /**
+   * @param index The index of a bucket.
+   * @return The largest value counted in the bucket.
+   */
+  static constexpr auto
+  GetUpperBound(           //
+      const size_t index)  //
+      -> uint64_t
+  {
+    if (index < kSubBucketNum) return index;
+
+    const auto shift = index / kSubBucketNum - 1;
+    const auto sub = index % kSubBucketNum;
+    return ((kSubBucketNum + sub + 1) << shift) - 1;
+  }
+
+ private:
+  /*############################################################################
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief The counts of each bucket.
+  std::array<uint64_t, kBucketNum> counts_{};
+
+  /// @brief The number of recorded values.
+  uint64_t total_{0};
+};
+
+/// @brief A histogram for attributing latency with at most 12.5% error.
+using LatencyHistogram = LogLinearHistogram<3>;
+
+/// @brief A high-dynamic-range histogram with at most 0.8% error.
+using HDRHistogram = LogLinearHistogram<7>;
+
+#endif  // PMWCAS_BENCHMARK_LATENCY_HISTOGRAM_HPP
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMWCAS_BENCHMARK_MICRO_OPERATION_ENGINE_HPP
+#define PMWCAS_BENCHMARK_MICRO_OPERATION_ENGINE_HPP
+
+// C++ standard libraries
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief A dummy operation for microbenchmarks.
+ *
+ * Each worker repeats the same primitive on its own words, so an operation
+ * does not have any parameter.
+ */
+struct MicroOperation {
+};
+
+class MicroOperationEngine
+{
+ public:
+  /*############################################################################
+   * Public utility functions
+   *##########################################################################*/
+
+  /**
+   * @param n The number of operations to be executed by each worker.
+   * @return A sequence of dummy operations.
+   */
+  auto
+  Generate(  //
+      const size_t n,
+      [[maybe_unused]] const size_t random_seed)  //
+      -> std::vector<MicroOperation>
+  {
+    return std::vector<MicroOperation>(n);
+  }
+};
+
+#endif  // PMWCAS_BENCHMARK_MICRO_OPERATION_ENGINE_HPP
@@ -0,0 +1,227 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMWCAS_BENCHMARK_MICRO_TARGET_HPP
+#define PMWCAS_BENCHMARK_MICRO_TARGET_HPP
+
+// C++ standard libraries
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// external system libraries
+#include <libpmemobj.h>
+
+// local sources
+#include "common.hpp"
+#include "competitor.hpp"
+#include "micro_operation_engine.hpp"
+
+/**
+ * @brief A list of building blocks measured by microbenchmarks.
+ *
+ */
+enum Primitive {
+  /// @brief `PLoad` of our PMwCAS library.
+  kPLoad,
+  /// @brief `PCAS` of our PMwCAS library.
+  kPCAS,
+  /// @brief `Get`, `Add`, and `PMwCAS` of our PMwCAS descriptors.
+  kPMwCASDesc,
+  /// @brief `AllocateDescriptor`, `AddEntry`, and `MwCAS` of microsoft/pmwcas.
+  kMicrosoftDesc,
+  /// @brief `Protect` and `Unprotect` of microsoft/pmwcas epochs.
+  kEpoch,
+  /// @brief `pmem_flush` and `pmem_drain` of libpmem.
+  kFlushFence,
+};
+
+/**
+ * @brief A list of placements of target words among workers.
+ *
+ */
+enum Sharing {
+  /// @brief Each worker uses its own cache lines.
+  kNoSharing,
+  /// @brief Workers use different words in the same cache lines.
+  kFalseSharing,
+  /// @brief Workers use the same words.
+  kTrueSharing,
+};
+
+/**
+ * @brief A class for measuring the building blocks of competitors.
+ *
+ */
+class MicroTarget
+{
+ public:
+  /*############################################################################
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Construct a new MicroTarget object.
+   *
+   * @param pmem_dir_str A path to persistent memory for benchmarking.
+   * @param primitive A building block to be measured.
+   * @param sharing A placement of target words among workers.
+   * @param target_num The number of target words for descriptors.
+   * @param dirty_lines Modify target lines before each primitive if true.
+   * @param thread_num The number of worker threads.
+   */
+  MicroTarget(  //
+      const std::string &pmem_dir_str,
+      const Primitive primitive,
+      const Sharing sharing,
+      const size_t target_num,
+      const bool dirty_lines,
+      const size_t thread_num);
+
+  MicroTarget(const MicroTarget &) = delete;
+  MicroTarget(MicroTarget &&) = delete;
+
+  MicroTarget &operator=(const MicroTarget &obj) = delete;
+  MicroTarget &operator=(MicroTarget &&) = delete;
+
+  /*############################################################################
+   * Public destructors
+   *##########################################################################*/
+
+  /**
+   * @brief Destroy the MicroTarget object.
+   *
+   */
+  ~MicroTarget();
+
+  /*############################################################################
+   * Setup/Teardown for workers
+   *##########################################################################*/
+
+  /**
+   * @brief Assign target words to the calling thread.
+   *
+   */
+  void SetUpForWorker();
+
+  constexpr void
+  TearDownForWorker()
+  {
+    // do nothing
+  }
+
+  /*############################################################################
+   * Public utilities
+   *##########################################################################*/
+
+  /**
+   * @brief Perform a primitive once.
+   *
+   * @return The number of executed operations (i.e., 1).
+   */
+  auto Execute(                   //
+      const MicroOperation &ops)  //
+      -> size_t;
+
+ private:
+  /*############################################################################
+   * Internal classes
+   *##########################################################################*/
+
+  /**
+   * @brief Target words of each worker padded to avoid false sharing.
+   *
+   */
+  struct alignas(kCacheLineSize) Worker {
+    /// @brief The addresses of target words.
+    uint64_t *addrs[kMaxTargetNum];
+
+    /// @brief The expected values of target words.
+    uint64_t vals[kMaxTargetNum];
+  };
+
+  /*############################################################################
+   * Internal utilities
+   *##########################################################################*/
+
+  /**
+   * @param worker_id The ID of a worker.
+   * @param i The index of a target word.
+   * @return The address of the i-th target word of a worker.
+   */
+  auto GetAddr(  //
+      const size_t worker_id,
+      const size_t i) const  //
+      -> uint64_t *;
+
+  /**
+   * @brief Modify the cache lines of target words without changing values.
+   *
+   * @param worker The target words of the calling thread.
+   * @param n The number of target words.
+   */
+  void MakeLinesDirty(  //
+      const Worker &worker,
+      const size_t n) const;
+
+  /*############################################################################
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief A path to persistent memory for benchmarking.
+  std::string pmem_dir_str_{};
+
+  /// @brief A building block to be measured.
+  Primitive primitive_{kPLoad};
+
+  /// @brief A placement of target words among workers.
+  Sharing sharing_{kNoSharing};
+
+  /// @brief The number of target words for descriptors.
+  size_t target_num_{1};
+
+  /// @brief A flag for modifying target lines before each primitive.
+  bool dirty_lines_{false};
+
+  /// @brief The number of worker threads.
+  size_t thread_num_{1};
+
+  /// @brief A pool for persistent memory.
+  PMEMobjpool *pop_{nullptr};
+
+  /// @brief The head address of target words.
+  uint64_t *words_{nullptr};
+
+  /// @brief A pool of our PMwCAS descriptors.
+  std::unique_ptr<PMwCAS> pmwcas_pool_{nullptr};
+
+  /// @brief A pool of microsoft/pmwcas descriptors.
+  std::unique_ptr<MicrosoftPMwCAS> microsoft_pool_{nullptr};
+
+  /// @brief A mutex for registering workers.
+  std::mutex worker_mtx_{};
+
+  /// @brief The target words of all the workers.
+  std::vector<std::unique_ptr<Worker>> workers_{};
+
+  /// @brief The target words of the calling thread.
+  inline static thread_local Worker *tls_worker_{nullptr};
+};
+
+#endif  // PMWCAS_BENCHMARK_MICRO_TARGET_HPP
@@ -19,8 +19,24 @@
 
 // C++ standard libraries
 #include <algorithm>
+#include <array>
 #include <cstddef>
-#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+// local sources
+#include "common.hpp"
+
+/**
+ * @brief A list of workloads for PMwCAS benchmarking.
+ *
+ */
+enum Workload {
+  /// @brief Increment all the target words by one.
+  kIncrement,
+  /// @brief Move money from a payer account to the other target accounts.
+  kTransfer,
+};
 
 class Operation
 {
@@ -48,13 +64,25 @@ class Operation
    *##########################################################################*/
 
   /**
-   * @return The target positions in an array.
+   * @return The number of target words.
+   */
+  [[nodiscard]] constexpr auto
+  GetTargetNum() const  //
+      -> size_t
+  {
+    return target_num_;
+  }
+
+  /**
+   * @param i The index of a target word.
+   * @return The position of the i-th target word in an array.
    */
-  constexpr auto
-  GetPositions() const  //
-      -> const std::vector<size_t> &
+  [[nodiscard]] constexpr auto
+  GetPosition(               //
+      const size_t i) const  //
+      -> size_t
   {
-    return targets_;
+    return targets_[i];
   }
 
   /**
@@ -63,6 +91,8 @@ class Operation
    * @param pos The position in an array.
    * @retval true if the position has been set.
    * @retval false otherwise.
+   * @throw std::out_of_range if this operation already has the maximum number
+   * of target words.
    * @note This function checks the uniqueness of given positions for
    * guaranteeing linearizability of PMwCAS operations.
    */
@@ -72,13 +102,71 @@ class Operation
       -> bool
   {
     // check the target address has been already set
-    const auto &cur_end = targets_.end();
+    const auto &cur_end = targets_.begin() + target_num_;
     if (std::find(targets_.begin(), cur_end, pos) != cur_end) return false;
+    if (target_num_ >= kMaxTargetNum) {
+      throw std::out_of_range{"An operation cannot have more target words."};
+    }
 
-    targets_.emplace_back(pos);
+    targets_[target_num_++] = pos;
     return true;
   }
 
+  /**
+   * @brief Set the amount of money transferred to each payee.
+   *
+   * The first target position is treated as a payer account.
+   *
+   * @param amount The amount of money for each payee.
+   */
+  constexpr void
+  SetTransferAmount(  //
+      const uint64_t amount)
+  {
+    amount_ = amount;
+  }
+
+  /**
+   * @retval true if this operation should use a single-word PCAS API.
+   * @retval false if this operation should use a PMwCAS API.
+   */
+  [[nodiscard]] constexpr auto
+  IsPCAS() const  //
+      -> bool
+  {
+    return pcas_;
+  }
+
+  /**
+   * @brief Mark this operation as a single-word PCAS.
+   *
+   */
+  constexpr void
+  SetPCAS()
+  {
+    pcas_ = true;
+  }
+
+  /**
+   * @return The index of a prepared queue that contains this operation.
+   */
+  [[nodiscard]] constexpr auto
+  GetQueueID() const  //
+      -> size_t
+  {
+    return queue_id_;
+  }
+
+  /**
+   * @param id The index of a prepared queue that contains this operation.
+   */
+  constexpr void
+  SetQueueID(  //
+      const uint32_t id)
+  {
+    queue_id_ = id;
+  }
+
   /*############################################################################
    * Public utility functions
    *##########################################################################*/
@@ -90,7 +178,46 @@ class Operation
   void
   SortTargets()
   {
-    std::sort(targets_.begin(), targets_.end());
+    if (target_num_ == 0) return;
+
+    const auto payer_pos = targets_.front();
+    const auto &end = targets_.begin() + target_num_;
+    std::sort(targets_.begin(), end);
+    payer_ = std::find(targets_.begin(), end, payer_pos) - targets_.begin();
+  }
+
+  /**
+   * @brief Compute desired values of target words.
+   *
+   * @tparam kTargetNum The number of target words (zero means a runtime value).
+   * @param old_vals The current values of target words.
+   * @param new_vals An output array for the desired values of target words.
+   * @retval true if target words should be swapped.
+   * @retval false if this operation does not need to modify any word.
+   * @note A transfer is skipped when the payer has insufficient balance.
+   */
+  template <size_t kTargetNum = 0>
+  auto
+  ComputeNewValues(  //
+      const uint64_t *old_vals,
+      uint64_t *new_vals) const  //
+      -> bool
+  {
+    const auto n = (kTargetNum > 0) ? kTargetNum : target_num_;
+    if (amount_ == 0) {
+      for (size_t i = 0; i < n; ++i) {
+        new_vals[i] = old_vals[i] + 1;
+      }
+      return true;
+    }
+
+    const auto total = amount_ * (n - 1);
+    if (old_vals[payer_] < total) return false;
+    for (size_t i = 0; i < n; ++i) {
+      new_vals[i] = old_vals[i] + amount_;
+    }
+    new_vals[payer_] = old_vals[payer_] - total;
+    return true;
   }
 
  private:
@@ -98,8 +225,23 @@ class Operation
    * Internal member variables
    *##########################################################################*/
 
-  /// @brief Target positions of an MwCAS operation
-  std::vector<size_t> targets_{};
+  /// @brief Target positions of an MwCAS operation (stored inline).
+  std::array<size_t, kMaxTargetNum> targets_{};
+
+  /// @brief The number of target positions.
+  size_t target_num_{0};
+
+  /// @brief The index of a payer in sorted targets.
+  size_t payer_{0};
+
+  /// @brief The amount of money for each payee (zero means increments).
+  uint64_t amount_{0};
+
+  /// @brief A flag for indicating a single-word PCAS operation.
+  bool pcas_{false};
+
+  /// @brief The index of a prepared queue (stored in padding).
+  uint32_t queue_id_{0};
 };
 
 #endif  // PMWCAS_BENCHMARK_ARRAY_OPERATION_HPP
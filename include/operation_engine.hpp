@@ -19,8 +19,14 @@
 
 // C++ standard libraries
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <random>
+#include <stdexcept>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -28,6 +34,8 @@
 #include "random/zipf.hpp"
 
 // local sources
+#include "common.hpp"
+#include "counter_rng.hpp"
 #include "operation.hpp"
 
 class OperationEngine
@@ -49,21 +57,24 @@ class OperationEngine
    * @param target_num The number of target words fow PMwCAS.
    * @param array_cap The capacity of an array.
    * @param skew_param A skew parameter in Zipf's law.
-   * @param random_seed A seed value for reproducibility.
+   * @param workload A workload type for generated operations.
+   * @param words_per_group The number of words co-located in each block.
+   * @param pcas_ratio The ratio of single-word PCAS operations (increment only).
    */
   OperationEngine(  //
       const size_t target_num,
       const size_t array_cap,
       const double skew_param,
-      const size_t random_seed)
-      : target_num_{target_num}, zipf_dist_{0, array_cap - 1, skew_param}
+      const Workload workload = kIncrement,
+      const size_t words_per_group = 1,
+      const double pcas_ratio = 0)
+      : target_num_{target_num},
+        array_cap_{array_cap},
+        workload_{workload},
+        words_per_group_{words_per_group},
+        pcas_ratio_{pcas_ratio},
+        zipf_dist_{0, array_cap / words_per_group - 1, skew_param}
   {
-    pos_index_.reserve(array_cap);
-    for (size_t i = 0; i < array_cap; ++i) {
-      pos_index_.emplace_back(i);
-    }
-    std::mt19937_64 rand_engine{random_seed};
-    std::shuffle(pos_index_.begin(), pos_index_.end(), rand_engine);
   }
 
   OperationEngine(const OperationEngine &) = default;
@@ -82,6 +93,105 @@ class OperationEngine
    * Public utility functions
    *##########################################################################*/
 
+  /**
+   * @brief Control the rate of conflicts by partitioning an array.
+   *
+   * The first `region_size` words form a region shared by all the workers, and
+   * the rest is split into private partitions. Each call of `Generate()` takes
+   * the next partition, and each operation selects its targets uniformly from
+   * the shared region with the given ratio or from its partition otherwise.
+   * Skew parameters and groups of words are ignored in this mode.
+   *
+   * @param thread_num The number of workers (i.e., private partitions).
+   * @param conflict_ratio The ratio of operations in the shared region.
+   * @param region_size The number of words in the shared region.
+   */
+  void
+  SetConflictControl(  //
+      const size_t thread_num,
+      const double conflict_ratio,
+      const size_t region_size)
+  {
+    partition_num_ = thread_num;
+    conflict_ratio_ = conflict_ratio;
+    region_size_ = region_size;
+    partition_size_ = (array_cap_ - region_size) / thread_num;
+    next_partition_ = std::make_shared<std::atomic_size_t>(0);
+  }
+
+  /**
+   * @brief Generate the operations of workers in parallel in advance.
+   *
+   * Each queue is split into chunks of `kChunkSize` operations, and each chunk
+   * uses its own stream of a counter-based random engine. Thus, the generated
+   * operations depend only on a seed and are the same as `Generate()` for any
+   * number of threads. The i-th worker uses the i-th partition for conflict
+   * control. Subsequent calls of `Generate()` with the seed of each worker
+   * return the prepared queues without generating them again. Each operation
+   * records the index of its queue (i.e., the worker).
+   *
+   * @param worker_num The number of workers.
+   * @param n The number of operations to be executed by each worker.
+   * @param random_seed A seed value for the first worker.
+   * @param thread_num The number of threads for generation.
+   */
+  void
+  Prepare(  //
+      const size_t worker_num,
+      const size_t n,
+      const size_t random_seed,
+      const size_t thread_num)
+  {
+    if (worker_num > std::numeric_limits<uint32_t>::max()) {
+      throw std::out_of_range{"Too many workers to identify their queues."};
+    }
+
+    auto prepared = std::make_shared<PreparedQueues>();
+    prepared->first_seed = random_seed;
+    auto &queues = prepared->queues;
+    queues.resize(worker_num);
+
+    // touch each queue in a generation thread rather than in the caller
+    ForEachTaskInParallel(worker_num, thread_num, [&](const size_t w) {  //
+      queues[w].resize(n);
+    });
+
+    const auto chunk_num = (n + kChunkSize - 1) / kChunkSize;
+    ForEachTaskInParallel(worker_num * chunk_num, thread_num, [&](const size_t task) {
+      const auto w = task / chunk_num;
+      GenerateChunk(queues[w], task % chunk_num, random_seed + w, w, static_cast<uint32_t>(w));
+    });
+    prepared_ = std::move(prepared);
+  }
+
+  /**
+   * @return Copies of prepared queues that are not handed over yet.
+   */
+  [[nodiscard]] auto
+  GetPreparedQueues() const  //
+      -> std::vector<std::vector<Operation>>
+  {
+    if (!prepared_) return {};
+    return prepared_->queues;
+  }
+
+  /**
+   * @param n The number of operations to be executed by each worker.
+   * @param random_seed A seed value of a worker.
+   * @retval true if `Generate()` hands over a prepared queue for the worker.
+   * @retval false otherwise.
+   */
+  [[nodiscard]] auto
+  IsPrepared(  //
+      const size_t n,
+      const size_t random_seed) const  //
+      -> bool
+  {
+    if (!prepared_ || random_seed - prepared_->first_seed >= prepared_->queues.size()) return false;
+    const auto &queue = prepared_->queues[random_seed - prepared_->first_seed];
+    return !queue.empty() && queue.size() == n;
+  }
+
   /**
    * @param n The number of operations to be executed by each worker.
    * @param random_seed A seed value for reproducibility.
@@ -93,42 +203,227 @@ class OperationEngine
       const size_t random_seed)  //
       -> std::vector<Operation>
   {
-    std::mt19937_64 rand_engine{random_seed};
+    // hand over a prepared queue only once
+    if (IsPrepared(n, random_seed)) {
+      auto &queue = prepared_->queues[random_seed - prepared_->first_seed];
+      auto operations = std::move(queue);
+      queue.clear();  // a moved-from vector is not guaranteed to be empty
+      return operations;
+    }
 
-    // generate an operation-queue for benchmarking
-    std::vector<Operation> operations;
-    operations.reserve(n);
-    for (size_t i = 0; i < n; ++i) {
-      // select target addresses for i-th operation
+    const auto id = (partition_num_ > 0) ? next_partition_->fetch_add(1, std::memory_order_relaxed)
+                                         : 0;
+    std::vector<Operation> operations(n);
+    for (size_t chunk = 0; chunk * kChunkSize < n; ++chunk) {
+      GenerateChunk(operations, chunk, random_seed, id);
+    }
+
+    return operations;
+  }
+
+ private:
+  /*############################################################################
+   * Internal constants
+   *##########################################################################*/
+
+  /// @brief The number of operations generated with each stream of random values.
+  static constexpr size_t kChunkSize = 1UL << 12UL;
+
+  /*############################################################################
+   * Internal classes
+   *##########################################################################*/
+
+  /**
+   * @brief Queues of operations generated in advance.
+   *
+   */
+  struct PreparedQueues {
+    /// @brief The seed value of the first worker.
+    size_t first_seed{0};
+
+    /// @brief The queues of operations for each worker.
+    std::vector<std::vector<Operation>> queues{};
+  };
+
+  /*############################################################################
+   * Internal utilities
+   *##########################################################################*/
+
+  /**
+   * @brief Process tasks with multiple threads in the order of their IDs.
+   *
+   * @tparam Func A function type that receives the ID of a task.
+   * @param task_num The number of tasks.
+   * @param thread_num The number of threads.
+   * @param func A function to process each task.
+   */
+  template <class Func>
+  static void
+  ForEachTaskInParallel(  //
+      const size_t task_num,
+      const size_t thread_num,
+      Func &&func)
+  {
+    std::atomic_size_t next_task{0};
+    auto worker = [&]() {
+      for (auto i = next_task.fetch_add(1, std::memory_order_relaxed); i < task_num;
+           i = next_task.fetch_add(1, std::memory_order_relaxed)) {
+        func(i);
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    const auto n = std::min(std::max<size_t>(thread_num, 1), task_num);
+    for (size_t i = 1; i < n; ++i) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &&t : threads) t.join();
+  }
+
+  /**
+   * @brief Generate a chunk of operations.
+   *
+   * @param operations A queue of operations.
+   * @param chunk The ID of a chunk in the queue.
+   * @param random_seed A seed value of the queue.
+   * @param partition_id The private partition of the queue for conflict control.
+   * @param queue_id The index of the queue in prepared ones.
+   */
+  void
+  GenerateChunk(  //
+      std::vector<Operation> &operations,
+      const size_t chunk,
+      const size_t random_seed,
+      const size_t partition_id,
+      const uint32_t queue_id = 0)
+  {
+    CounterRNG rand_engine{random_seed, chunk};
+    std::uniform_int_distribution<size_t> payee_dist{1, std::max<size_t>(target_num_, 2) - 1};
+    std::uniform_int_distribution<uint64_t> amount_dist{1, kMaxTransferAmount};
+    std::uniform_int_distribution<size_t> offset_dist{0, words_per_group_ - 1};
+    std::bernoulli_distribution pcas_dist{pcas_ratio_};
+
+    // prepare the shared region and a private partition for conflict control
+    std::bernoulli_distribution conflict_dist{conflict_ratio_};
+    std::uniform_int_distribution<size_t> region_dist{0, std::max<size_t>(region_size_, 1) - 1};
+    std::uniform_int_distribution<size_t> partition_dist{};
+    if (partition_num_ > 0) {
+      const auto head = region_size_ + (partition_id % partition_num_) * partition_size_;
+      partition_dist = std::uniform_int_distribution<size_t>{head, head + partition_size_ - 1};
+    }
+
+    const auto end = std::min((chunk + 1) * kChunkSize, operations.size());
+    for (size_t i = chunk * kChunkSize; i < end; ++i) {
+      // each transfer moves money among a payer and 1--(k-1) payees
+      auto target_num = target_num_;
       Operation ops{};
-      for (size_t j = 0; j < target_num_; ++j) {
-        auto pos = zipf_dist_(rand_engine);
-        while (!ops.SetPositionIfUnique(pos)) {
-          // continue until the different target is selected
-          pos = zipf_dist_(rand_engine);
+      if (workload_ == kTransfer) {
+        target_num = payee_dist(rand_engine) + 1;
+        ops.SetTransferAmount(amount_dist(rand_engine));
+      } else if (pcas_ratio_ > 0 && pcas_dist(rand_engine)) {
+        // mix single-word PCAS into PMwCAS operations on the same array
+        target_num = 1;
+        ops.SetPCAS();
+      }
+
+      // select target addresses for i-th operation
+      if (partition_num_ > 0) {
+        auto &dist = (conflict_dist(rand_engine)) ? region_dist : partition_dist;
+        for (size_t j = 0; j < target_num; ++j) {
+          while (!ops.SetPositionIfUnique(dist(rand_engine))) {
+            // continue until the different target is selected
+          }
+        }
+      } else if (words_per_group_ == 1) {
+        for (size_t j = 0; j < target_num; ++j) {
+          auto pos = zipf_dist_(rand_engine);
+          while (!ops.SetPositionIfUnique(pos)) {
+            // continue until the different target is selected
+            pos = zipf_dist_(rand_engine);
+          }
         }
+      } else {
+        SetCoLocatedPositions(ops, target_num, offset_dist, rand_engine);
       }
       ops.SortTargets();
+      ops.SetQueueID(queue_id);
 
-      operations.emplace_back(std::move(ops));
+      operations[i] = std::move(ops);
     }
+  }
 
-    return operations;
+  /**
+   * @brief Select target positions so that they share as few groups as possible.
+   *
+   * @param ops An operation to be set target positions.
+   * @param target_num The number of target words.
+   * @param offset_dist A distribution for selecting words in a group.
+   * @param rand_engine A random engine.
+   * @note Each group is selected according to Zipf's law and filled with
+   * targets before the next group is selected. This may not terminate if an
+   * array has too few groups for the targets, so the benchmark requires
+   * `words_per_group` to be at least the number of target words.
+   */
+  void
+  SetCoLocatedPositions(  //
+      Operation &ops,
+      const size_t target_num,
+      std::uniform_int_distribution<size_t> &offset_dist,
+      CounterRNG &rand_engine)
+  {
+    size_t cnt = 0;
+    while (cnt < target_num) {
+      // a group that is already used is full, so select another one
+      const auto head = zipf_dist_(rand_engine) * words_per_group_;
+      if (!ops.SetPositionIfUnique(head + offset_dist(rand_engine))) continue;
+
+      const auto end = std::min(cnt + words_per_group_, target_num);
+      for (++cnt; cnt < end;) {
+        if (ops.SetPositionIfUnique(head + offset_dist(rand_engine))) ++cnt;
+      }
+    }
   }
 
- private:
   /*############################################################################
    * Internal member variables
    *##########################################################################*/
 
-  /// @brief The index for indicating actual positions in an array.
-  std::vector<size_t> pos_index_{};
-
   /// @brief The number of target words for PMwCAS.
   size_t target_num_{};
 
+  /// @brief The capacity of an array.
+  size_t array_cap_{};
+
+  /// @brief A workload type for generated operations.
+  Workload workload_{kIncrement};
+
+  /// @brief The number of words co-located in each block.
+  size_t words_per_group_{1};
+
+  /// @brief The ratio of single-word PCAS operations.
+  double pcas_ratio_{0};
+
   /// @brief A random value generator according to Zipf's law.
   ZipfDist_t zipf_dist_{};
+
+  /// @brief The number of private partitions (zero disables conflict control).
+  size_t partition_num_{0};
+
+  /// @brief The ratio of operations in a shared conflict region.
+  double conflict_ratio_{0};
+
+  /// @brief The number of words in a shared conflict region.
+  size_t region_size_{0};
+
+  /// @brief The number of words in each private partition.
+  size_t partition_size_{0};
+
+  /// @brief The next partition to be assigned (shared among copies of this engine).
+  std::shared_ptr<std::atomic_size_t> next_partition_{nullptr};
+
+  /// @brief Queues generated in advance (shared among copies of this engine).
+  std::shared_ptr<PreparedQueues> prepared_{nullptr};
 };
 
 #endif  // PMWCAS_BENCHMARK_ARRAY_OPERATION_ENGINE_HPP
@@ -0,0 +1,347 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMWCAS_BENCHMARK_PMEM_EMULATOR_HPP
+#define PMWCAS_BENCHMARK_PMEM_EMULATOR_HPP
+
+// C++ standard libraries
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+// system headers
+#include <sched.h>
+#include <x86intrin.h>
+
+// local sources
+#include "tsc_clock.hpp"
+
+/*##############################################################################
+ * Persistence modes
+ *############################################################################*/
+
+/**
+ * @brief A list of instructions for persisting cache lines.
+ *
+ */
+enum PersistMode {
+  /// @brief Use the instructions that each competitor selects.
+  kNativePersist,
+  /// @brief Flush each line with CLFLUSH.
+  kClflush,
+  /// @brief Flush each line with CLFLUSHOPT.
+  kClflushopt,
+  /// @brief Write back each line with CLWB.
+  kClwb,
+  /// @brief Elide flushes but keep fences (i.e., eADR platforms).
+  kEADR,
+};
+
+/*##############################################################################
+ * Emulated latency of persistent memory
+ *############################################################################*/
+
+/**
+ * @brief A persistence mode and delays injected into persistence paths.
+ *
+ * Note that this header is also force-included into microsoft/pmwcas, so it
+ * must be compilable with C++11.
+ */
+struct PMEMDelay {
+  /// @brief An instruction for persisting cache lines.
+  PersistMode mode{kNativePersist};
+
+  /// @brief A delay for flushing each cache line.
+  uint64_t flush{0};
+
+  /// @brief A delay for each store fence.
+  uint64_t fence{0};
+
+  /// @brief A delay for reading each target word in an array.
+  uint64_t read{0};
+};
+
+/**
+ * @return The global configuration of a persistence mode and emulated delays.
+ */
+inline auto
+GetPMEMDelay()  //
+    -> PMEMDelay &
+{
+  static PMEMDelay delay{};
+  return delay;
+}
+
+/**
+ * @brief Spin for a given number of TSC cycles.
+ *
+ * @param cycles The number of cycles to wait.
+ */
+inline void
+SpinFor(  //
+    const uint64_t cycles)
+{
+  if (cycles == 0) return;
+
+  const auto begin = __rdtsc();
+  while (__rdtsc() - begin < cycles) {
+    _mm_pause();
+  }
+}
+
+/**
+ * @brief Set emulated delays in nanoseconds.
+ *
+ * @param flush_ns A delay for flushing each cache line.
+ * @param fence_ns A delay for each store fence.
+ * @param read_ns A delay for reading each target word in an array.
+ */
+inline void
+ConfigurePMEMDelay(  //
+    const uint64_t flush_ns,
+    const uint64_t fence_ns,
+    const uint64_t read_ns)
+{
+  const auto cycles_per_ns = TSCClock{}.GetCyclesPerNano();
+  auto &delay = GetPMEMDelay();
+  delay.flush = static_cast<uint64_t>(flush_ns * cycles_per_ns);
+  delay.fence = static_cast<uint64_t>(fence_ns * cycles_per_ns);
+  delay.read = static_cast<uint64_t>(read_ns * cycles_per_ns);
+}
+
+/**
+ * @brief Set an instruction for persisting cache lines.
+ *
+ * @param mode A persistence mode.
+ */
+inline void
+SetPersistMode(  //
+    const PersistMode mode)
+{
+  GetPMEMDelay().mode = mode;
+}
+
+/**
+ * @brief Wait for the emulated latency of flushing a given region.
+ *
+ * @param addr The head address of a flushed region.
+ * @param size The size of a flushed region.
+ */
+inline void
+EmulateFlush(  //
+    const void *addr,
+    const size_t size)
+{
+  constexpr uintptr_t kLineSize = 64;
+  const auto head = reinterpret_cast<uintptr_t>(addr) / kLineSize;
+  const auto tail = (reinterpret_cast<uintptr_t>(addr) + (size > 0 ? size - 1 : 0)) / kLineSize;
+  SpinFor((tail - head + 1) * GetPMEMDelay().flush);
+}
+
+/**
+ * @brief Wait for the emulated latency of a store fence.
+ *
+ */
+inline void
+EmulateFence()
+{
+  SpinFor(GetPMEMDelay().fence);
+}
+
+/**
+ * @brief Wait for the emulated latency of reading target words.
+ *
+ * @param n The number of target words.
+ */
+inline void
+EmulateRead(  //
+    const size_t n)
+{
+  SpinFor(n * GetPMEMDelay().read);
+}
+
+/*##############################################################################
+ * Preemption inside persistence paths
+ *############################################################################*/
+
+/**
+ * @brief A preemption armed by a worker for its current attempt.
+ *
+ * An armed preemption fires in the first persistence hook after one of the
+ * target words has been modified, that is, while a descriptor or new values
+ * of the worker are published but not yet persisted.
+ */
+struct PendingPreemption {
+  /// @brief The addresses of target words.
+  const uint64_t *const *addrs{nullptr};
+
+  /// @brief The values of target words read before the attempt.
+  const uint64_t *old_vals{nullptr};
+
+  /// @brief The number of target words (zero means not armed).
+  size_t n{0};
+
+  /// @brief The length of a preemption in microseconds (zero means `sched_yield`).
+  uint64_t sleep_us{0};
+};
+
+/**
+ * @return The preemption armed by the calling thread.
+ */
+inline auto
+GetPendingPreemption()  //
+    -> PendingPreemption &
+{
+  static thread_local PendingPreemption pending{};
+  return pending;
+}
+
+/**
+ * @brief Yield or sleep the calling thread.
+ *
+ * @param sleep_us The length of a preemption in microseconds (zero means
+ * `sched_yield`).
+ */
+inline void
+Preempt(  //
+    const uint64_t sleep_us)
+{
+  if (sleep_us == 0) {
+    sched_yield();
+  } else {
+    std::this_thread::sleep_for(std::chrono::microseconds{sleep_us});
+  }
+}
+
+/**
+ * @brief Fire an armed preemption if one of its target words has been modified.
+ *
+ */
+inline void
+PreemptIfPublished()
+{
+  auto &pending = GetPendingPreemption();
+  for (size_t i = 0; i < pending.n; ++i) {
+    if (__atomic_load_n(pending.addrs[i], __ATOMIC_RELAXED) != pending.old_vals[i]) {
+      pending.n = 0;
+      Preempt(pending.sleep_us);
+      return;
+    }
+  }
+}
+
+/*##############################################################################
+ * Flush instructions selected at runtime
+ *############################################################################*/
+
+__attribute__((target("clflushopt"))) inline void
+FlushByClflushopt(  //
+    const void *addr)
+{
+  _mm_clflushopt(const_cast<void *>(addr));
+}
+
+__attribute__((target("clwb"))) inline void
+FlushByClwb(  //
+    const void *addr)
+{
+  _mm_clwb(const_cast<void *>(addr));
+}
+
+/**
+ * @brief Persist cache lines with the selected instruction.
+ *
+ * @param addr The head address of a flushed region.
+ * @param size The size of a flushed region.
+ * @retval true if the lines have been flushed or the flush has been elided.
+ * @retval false if a caller should use its native instruction.
+ */
+inline auto
+FlushBySelectedMode(  //
+    const void *addr,
+    const size_t size)  //
+    -> bool
+{
+  constexpr uintptr_t kLineSize = 64;
+  const auto mode = GetPMEMDelay().mode;
+  if (mode == kNativePersist) return false;
+  if (mode == kEADR) return true;
+
+  const auto head = reinterpret_cast<uintptr_t>(addr) & ~(kLineSize - 1);
+  const auto tail = reinterpret_cast<uintptr_t>(addr) + (size > 0 ? size : 1);
+  for (auto line = head; line < tail; line += kLineSize) {
+    const auto *ptr = reinterpret_cast<const void *>(line);
+    if (mode == kClflush) {
+      _mm_clflush(ptr);
+    } else if (mode == kClflushopt) {
+      FlushByClflushopt(ptr);
+    } else {
+      FlushByClwb(ptr);
+    }
+  }
+  return true;
+}
+
+/*##############################################################################
+ * Hooks replacing flush/fence instructions in microsoft/pmwcas
+ *############################################################################*/
+
+template <class T>
+inline void
+EmulatedClflush(  //
+    T *addr)
+{
+  PreemptIfPublished();
+  EmulateFlush(addr, 1);
+  if (!FlushBySelectedMode(addr, 1)) {
+    _mm_clflush(addr);
+  }
+}
+
+template <class T>
+inline void
+EmulatedClflushopt(  //
+    T *addr)
+{
+  PreemptIfPublished();
+  EmulateFlush(addr, 1);
+  if (!FlushBySelectedMode(addr, 1)) {
+    _mm_clflushopt(addr);
+  }
+}
+
+template <class T>
+inline void
+EmulatedClwb(  //
+    T *addr)
+{
+  PreemptIfPublished();
+  EmulateFlush(addr, 1);
+  if (!FlushBySelectedMode(addr, 1)) {
+    _mm_clwb(addr);
+  }
+}
+
+inline void
+EmulatedSfence()
+{
+  PreemptIfPublished();
+  EmulateFence();
+  _mm_sfence();
+}
+
+#endif  // PMWCAS_BENCHMARK_PMEM_EMULATOR_HPP
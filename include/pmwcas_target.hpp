@@ -18,17 +18,98 @@
 #define PMWCAS_BENCHMARK_ARRAY_PMWCAS_TARGET_HPP
 
 // C++ standard libraries
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 // external system libraries
 #include <libpmemobj.h>
 
 // local sources
 #include "common.hpp"
+#include "contention_manager.hpp"
+#include "latency_histogram.hpp"
 #include "operation.hpp"
+#include "value_codec.hpp"
+
+/**
+ * @brief Sizing parameters for pools of PMwCAS descriptors.
+ *
+ * Zero values mean the defaults of each implementation. Note that our PMwCAS
+ * always prepares one descriptor for each thread, so it ignores these values.
+ */
+struct DescPoolConfig {
+  /// @brief The size of a pmemobj pool for descriptors in bytes.
+  size_t pool_size{0};
+
+  /// @brief The total number of descriptors.
+  size_t capacity{0};
+
+  /// @brief The number of partitions of descriptors.
+  size_t partition{0};
+};
+
+/**
+ * @brief Statistics of single-word PCAS and multi-word PMwCAS operations.
+ *
+ */
+struct OpTypeStats {
+  /// @brief The number of executed PCAS operations.
+  size_t pcas_num{0};
+
+  /// @brief The total latency of PCAS operations in nanoseconds.
+  size_t pcas_ns{0};
+
+  /// @brief The number of executed PMwCAS operations.
+  size_t pmwcas_num{0};
+
+  /// @brief The total latency of PMwCAS operations in nanoseconds.
+  size_t pmwcas_ns{0};
+
+  /// @brief A latency histogram of PCAS operations in nanoseconds.
+  LatencyHistogram pcas_hist{};
+
+  /// @brief A latency histogram of PMwCAS operations in nanoseconds.
+  LatencyHistogram pmwcas_hist{};
+
+  /**
+   * @brief Add the statistics of another worker or process.
+   *
+   * @param other Statistics to be merged.
+   */
+  constexpr void
+  Merge(  //
+      const OpTypeStats &other)
+  {
+    pcas_num += other.pcas_num;
+    pcas_ns += other.pcas_ns;
+    pmwcas_num += other.pmwcas_num;
+    pmwcas_ns += other.pmwcas_ns;
+    pcas_hist.Merge(other.pcas_hist);
+    pmwcas_hist.Merge(other.pmwcas_hist);
+  }
+};
+
+/**
+ * @brief Sampled lags between the current and reclaimable epochs.
+ *
+ */
+struct EpochLag {
+  /// @brief The number of samples.
+  size_t sample_num{0};
+
+  /// @brief The sum of sampled lags in epochs.
+  size_t sum{0};
+
+  /// @brief The maximum sampled lag in epochs.
+  size_t max{0};
+};
 
 /**
  * @brief A class to deal with MwCAS target data and algorthms.
@@ -39,6 +120,19 @@ template <class Implementation>
 class PMwCASTarget
 {
  public:
+  /*############################################################################
+   * Public constants
+   *##########################################################################*/
+
+  /// @brief The number of classes of Zipf ranks for attributing latency.
+  static constexpr size_t kRankClassNum = 16;
+
+  /// @brief The number of classes of retry counts for attributing latency.
+  static constexpr size_t kRetryClassNum = 5;
+
+  /// @brief The number of nodes that each worker reserves at once for pointer values.
+  static constexpr size_t kNodeChunkSize = 1024;
+
   /*############################################################################
    * Public constructors and assignment operators
    *##########################################################################*/
@@ -49,11 +143,19 @@ class PMwCASTarget
    * @param pmem_dir_str A path to persistent memory for benchmarking.
    * @param array_cap The capacity of an array.
    * @param block_size The size of each memory block.
+   * @param words_per_group The number of words co-located in each block.
+   * @param segment_size The size of array blocks in each pool file in bytes
+   * (zero means a single pool file). Each file also holds one extra block for
+   * alignment and `PMEMOBJ_MIN_POOL` bytes of pool metadata.
+   * @param desc_config Sizing parameters for a pool of descriptors.
    */
   PMwCASTarget(  //
       const std::string &pmem_dir_str,
       const size_t array_cap,
-      const size_t block_size);
+      const size_t block_size,
+      const size_t words_per_group = 1,
+      const size_t segment_size = 0,
+      const DescPoolConfig &desc_config = DescPoolConfig{});
 
   PMwCASTarget(const PMwCASTarget &) = delete;
   PMwCASTarget(PMwCASTarget &&) = delete;
@@ -75,17 +177,22 @@ class PMwCASTarget
    * Setup/Teardown for workers
    *##########################################################################*/
 
-  constexpr void
+  /**
+   * @brief Register the calling thread as a worker for collecting statistics.
+   *
+   */
+  void
   SetUpForWorker()
   {
-    // do nothing
+    // each run follows a queue from its head
+    GetWorkerStats().prefetch_queue = nullptr;
   }
 
-  constexpr void
-  TearDownForWorker()
-  {
-    // do nothing
-  }
+  /**
+   * @brief Complete the operations left in flight by the calling thread.
+   *
+   */
+  void TearDownForWorker();
 
   /*############################################################################
    * Public utilities
@@ -93,44 +200,827 @@ class PMwCASTarget
 
   /**
    * @param pos The position in an array.
-   * @return The current value.
+   * @return The current value (decoded if values are encoded).
    */
   auto GetValue(               //
       const size_t pos) const  //
       -> uint64_t;
 
   /**
-   * @brief Perform a PMwCAS operation.
+   * @brief Set all the words in an array to a given value.
+   *
+   * @param val An initial value.
+   * @param thread_num The number of threads for initialization.
+   */
+  void Fill(  //
+      const uint64_t val,
+      const size_t thread_num);
+
+  /**
+   * @param thread_num The number of threads for scanning.
+   * @return The sum of all the words in an array (decoded if values are encoded).
+   */
+  auto Sum(                           //
+      const size_t thread_num) const  //
+      -> uint64_t;
+
+  /**
+   * @return The total size of pool files for an array in bytes.
+   */
+  auto GetArrayFileSize() const  //
+      -> size_t;
+
+  /**
+   * @return The total size of pool files for descriptors in bytes.
+   */
+  auto GetDescPoolFileSize() const  //
+      -> size_t;
+
+  /**
+   * @return The number of descriptors prepared in a pool.
+   */
+  [[nodiscard]] constexpr auto
+  GetDescCapacity() const  //
+      -> size_t
+  {
+    return desc_capacity_;
+  }
+
+  /**
+   * @brief Prepare resources for workers in forked processes.
+   *
+   * Thread IDs are assigned in each process, so our PMwCAS gives each process
+   * its own pool of descriptors. This must be called before forking.
+   *
+   * @param process_num The number of worker processes.
+   * @throws std::runtime_error if a competitor cannot be shared among processes.
+   */
+  void PrepareProcesses(  //
+      size_t process_num);
+
+  /**
+   * @brief Open and map the pool files of this target in the calling process.
+   *
+   * Each pool file is mapped again at the address inherited from a parent
+   * process and its pages are populated, so addresses in target words and
+   * descriptors are valid in every process.
+   *
+   * @param process_id The ID of the calling process.
+   */
+  void AttachProcess(  //
+      size_t process_id);
+
+  /**
+   * @return The total number of operations executed by all the workers.
+   */
+  auto GetExecNum() const  //
+      -> size_t;
+
+  /**
+   * @return The number of operations that failed at least once (or waited for
+   * a lock in the blocking baseline), summed over all the workers.
+   */
+  auto GetConflictNum() const  //
+      -> size_t;
+
+  /**
+   * @return The statistics of each operation type summed over all the workers.
+   * @note Latency is only collected after `EnableOpTypeLatency()`.
+   */
+  auto GetOpTypeStats() const  //
+      -> OpTypeStats;
+
+  /**
+   * @brief Measure the latency of each operation type in `Execute()`.
+   *
+   */
+  constexpr void
+  EnableOpTypeLatency()
+  {
+    measure_type_latency_ = true;
+  }
+
+  /**
+   * @brief Record latency by the Zipf rank of the hottest target and retries.
+   *
+   * This must be called before workers are registered.
+   */
+  constexpr void
+  EnableContentionBreakdown()
+  {
+    measure_contention_ = true;
+  }
+
+  /**
+   * @return Latency histograms merged over all the workers, indexed by
+   * `rank_class * kRetryClassNum + retry_class`.
+   */
+  auto GetContentionHistograms() const  //
+      -> std::vector<LatencyHistogram>;
+
+  /**
+   * @brief Record the latency of each operation in TSC cycles.
+   *
+   * Each worker counts cycles in its own fixed-size histogram and merges it
+   * into a shared one without locks in `TearDownForWorker()`. This must be
+   * called before workers are registered.
+   */
+  constexpr void
+  EnableTSCLatency()
+  {
+    measure_tsc_latency_ = true;
+  }
+
+  /**
+   * @return A latency histogram in TSC cycles merged over finished workers.
+   */
+  [[nodiscard]] constexpr auto
+  GetTSCLatencyHistogram() const  //
+      -> const HDRHistogram &
+  {
+    return tsc_hist_;
+  }
+
+  /**
+   * @param rank The Zipf rank of a target (zero is the hottest).
+   * @return A class of ranks in [2^c - 1, 2^(c+1) - 1).
+   */
+  static constexpr auto
+  GetRankClass(           //
+      const size_t rank)  //
+      -> size_t
+  {
+    const auto c = Log2(rank + 1);
+    return (c < kRankClassNum) ? c : kRankClassNum - 1;
+  }
+
+  /**
+   * @param retry The number of failed attempts.
+   * @return A class of retries: 0, 1, 2--3, 4--7, or 8+.
+   */
+  static constexpr auto
+  GetRetryClass(           //
+      const size_t retry)  //
+      -> size_t
+  {
+    if (retry == 0) return 0;
+    const auto c = Log2(retry) + 1;
+    return (c < kRetryClassNum) ? c : kRetryClassNum - 1;
+  }
+
+  /**
+   * @brief Set a policy for failed attempts used by workers registered later.
+   *
+   * @param policy A policy for failed attempts.
+   */
+  constexpr void
+  SetContentionPolicy(  //
+      const ContentionPolicy policy)
+  {
+    contention_policy_ = policy;
+  }
+
+  /**
+   * @brief Encode values written into target words.
+   *
+   * In pointer mode, each operation writes its new values into fresh nodes in
+   * a second pool and swaps the addresses of them. Nodes are never reused, so
+   * the pool must hold a node for each target of all the successful operations.
+   * This must be called before `Fill()` and before workers are registered.
+   *
+   * @param mode An encoding of values.
+   * @param node_num The number of nodes allocated by workers in pointer mode
+   * (see `GetNodeNum()`).
+   * @throws std::runtime_error if values use bits reserved by a competitor.
+   */
+  void SetValueMode(  //
+      ValueMode mode,
+      size_t node_num = 0);
+
+  /**
+   * @param worker_num The number of workers (summed over repeated runs).
+   * @param exec_num The number of operations executed by each worker.
+   * @param target_num The maximum number of target words of each operation.
+   * @return The number of nodes allocated by workers in pointer mode.
+   */
+  static constexpr auto
+  GetNodeNum(  //
+      const size_t worker_num,
+      const size_t exec_num,
+      const size_t target_num)  //
+      -> size_t
+  {
+    // a worker abandons its chunk when it cannot hold the targets of an operation
+    const auto ops_per_chunk = (kNodeChunkSize - target_num + 1) / target_num;
+    const auto chunk_num = (exec_num + ops_per_chunk - 1) / ops_per_chunk;
+    return worker_num * chunk_num * kNodeChunkSize;
+  }
+
+  /**
+   * @brief Specialize `Execute()` on the number of target words.
+   *
+   * @param target_num The number of target words of every operation (zero
+   * means that each operation has its own number of target words).
+   */
+  void SetFixedTargetNum(  //
+      const size_t target_num);
+
+  /**
+   * @brief Preempt workers in the middle of operations periodically.
+   *
+   * A preemption is armed after a worker reads its target words, and it fires
+   * in the first persistence hook after one of the words has been modified
+   * (i.e., while a descriptor or new values are published and locks are held
+   * for the blocking baseline). If no hook fires, for example because an
+   * attempt fails without publishing anything or persistence paths are not
+   * hooked (see PMWCAS_BENCH_EMULATE_PMEM), the worker is preempted at the end
+   * of the attempt.
+   *
+   * @param interval The number of attempts between preemptions of each worker
+   * (zero disables preemption).
+   * @param sleep_us The length of each preemption in microseconds (zero means
+   * `sched_yield`).
+   */
+  constexpr void
+  SetPreemption(  //
+      const size_t interval,
+      const size_t sleep_us)
+  {
+    preempt_interval_ = interval;
+    preempt_sleep_us_ = sleep_us;
+  }
+
+  /**
+   * @brief Set the number of operations in each epoch of microsoft/pmwcas.
+   *
+   * @param ops_per_epoch The number of operations that each worker executes
+   * between `Protect()` and `Unprotect()` (zero means a whole worker run).
+   */
+  constexpr void
+  SetEpochScope(  //
+      const size_t ops_per_epoch)
+  {
+    epoch_scope_ = ops_per_epoch;
+  }
+
+  /**
+   * @brief Sample the lag of descriptor reclamation after each operation.
+   *
+   */
+  constexpr void
+  EnableEpochLag()
+  {
+    measure_epoch_lag_ = true;
+  }
+
+  /**
+   * @return Lags of descriptor reclamation summed over all the workers.
+   * @note Lags are only sampled for microsoft/pmwcas after `EnableEpochLag()`.
+   */
+  auto GetEpochLag() const  //
+      -> EpochLag;
+
+  /**
+   * @brief Interleave the prefetches of independent operations in each worker.
+   *
+   * This is prefetch-only interleaving: the loads of target words overlap with
+   * the attempts of other operations, but each attempt still runs a whole
+   * PMwCAS including flushes and fences. The last operation of each worker
+   * completes all the operations left in flight, so they are counted in the
+   * results of `Execute()`.
+   *
+   * @param width The number of operations in flight in each worker (one
+   * means that each operation is completed before the next one).
+   * @param exec_num The number of operations executed by each worker.
+   */
+  constexpr void
+  SetInterleaveWidth(  //
+      const size_t width,
+      const size_t exec_num)
+  {
+    interleave_width_ = width;
+    interleave_exec_num_ = exec_num;
+  }
+
+  /**
+   * @brief Prefetch the targets of upcoming operations in each worker's queue.
+   *
+   * This object keeps copies of the queues, and each worker follows its own
+   * queue (selected by the queue ID of its first operation) with a cursor.
+   * Thus, each worker must execute all the operations of its queue in order.
+   *
+   * @param queues Copies of the queues of all the workers.
+   * @param distance The number of operations to look ahead (zero disables
+   * prefetching).
+   */
+  void
+  SetPrefetchQueues(  //
+      std::vector<std::vector<Operation>> queues,
+      const size_t distance)
+  {
+    prefetch_queues_ = std::move(queues);
+    prefetch_distance_ = distance;
+  }
+
+  /**
+   * @brief Perform a PMwCAS (or single-word PCAS) operation.
    *
    * @param ops An operation to be executed.
-   * @return The number of executed operations (i.e., 1).
+   * @return The number of completed operations (i.e., 1 without interleaving,
+   * or 0--1 with interleaving).
    */
   auto Execute(              //
       const Operation &ops)  //
       -> size_t;
 
+  /**
+   * @brief Perform all the operations in a worker's queue.
+   *
+   * Unlike `Execute()`, this selects the code specialized on the number of
+   * target words once per queue instead of once per operation.
+   *
+   * @param queue The operations of a worker.
+   * @return The number of completed operations.
+   */
+  auto ExecuteAll(                        //
+      const std::vector<Operation> &queue)  //
+      -> size_t;
+
  private:
+  /*############################################################################
+   * Internal types
+   *##########################################################################*/
+
+  /*############################################################################
+   * Internal classes
+   *##########################################################################*/
+
+  /**
+   * @brief An operation in flight of interleaved execution.
+   *
+   */
+  struct InFlight {
+    /// @brief A copy of an issued operation.
+    Operation ops{};
+
+    /// @brief A flag for indicating that this slot holds an incomplete operation.
+    bool busy{false};
+
+    /// @brief A flag for indicating that an attempt of this operation has failed.
+    bool failed{false};
+
+    /// @brief The total time of attempts of this operation in nanoseconds.
+    size_t ns{0};
+  };
+
+  /**
+   * @brief Statistics of each worker padded to avoid false sharing.
+   *
+   */
+  struct alignas(kCacheLineSize) WorkerStats {
+    /// @brief The number of operations executed by a worker.
+    size_t exec_num{0};
+
+    /// @brief The number of operations that failed at least once.
+    size_t conflict_num{0};
+
+    /// @brief The statistics of each operation type.
+    OpTypeStats types{};
+
+    /// @brief A manager for waiting before retrying failed attempts.
+    ContentionManager cm{};
+
+    /// @brief The slots of operations in flight for interleaved execution.
+    std::vector<InFlight> slots{};
+
+    /// @brief The slot to be completed next.
+    size_t cursor{0};
+
+    /// @brief The number of operations issued in interleaved execution.
+    size_t issued_num{0};
+
+    /// @brief The number of attempts until the next preemption.
+    int64_t preempt_countdown{0};
+
+    /// @brief Latency histograms for each class of ranks and retries.
+    std::vector<LatencyHistogram> hists{};
+
+    /// @brief A latency histogram in TSC cycles.
+    std::unique_ptr<HDRHistogram> tsc_hist{nullptr};
+
+    /// @brief A flag for indicating that a worker is in a protected epoch.
+    bool in_epoch{false};
+
+    /// @brief The number of operations until leaving the current epoch.
+    size_t epoch_countdown{0};
+
+    /// @brief Sampled lags of descriptor reclamation.
+    EpochLag epoch_lag{};
+
+    /// @brief The next node to be written in pointer mode.
+    size_t node_head{0};
+
+    /// @brief The end of nodes reserved by a worker.
+    size_t node_end{0};
+
+    /// @brief The queue of a worker for prefetching upcoming operations.
+    const std::vector<Operation> *prefetch_queue{nullptr};
+
+    /// @brief The position of the current operation in the queue.
+    size_t prefetch_pos{0};
+  };
+
+  /**
+   * @brief Member functions specialized on the number of target words.
+   *
+   */
+  struct SpecializedFuncs {
+    /// @brief `ExecuteOne()` for executing an operation.
+    size_t (PMwCASTarget::*execute)(const Operation &, WorkerStats &){nullptr};
+
+    /// @brief `ExecuteQueue()` for executing the operations of a worker.
+    size_t (PMwCASTarget::*execute_all)(const std::vector<Operation> &, WorkerStats &){nullptr};
+
+    /// @brief `Drain()` for completing operations in flight.
+    size_t (PMwCASTarget::*drain)(WorkerStats &){nullptr};
+  };
+
   /*############################################################################
    * Internal utilities
    *##########################################################################*/
 
   /**
-   * @param pos The position in memory blocks.
+   * @return The statistics of the calling thread.
+   * @note A thread is registered as a new worker when it first calls this.
+   */
+  auto
+  GetWorkerStats()  //
+      -> WorkerStats &
+  {
+    if (tls_target_id_ != id_) RegisterWorker();
+    return *tls_stats_;
+  }
+
+  /**
+   * @brief Assign new statistics to the calling thread.
+   *
+   */
+  void RegisterWorker();
+
+  /**
+   * @brief Prefetch the targets of an upcoming operation in a worker's queue.
+   *
+   * @param ops The operation being executed.
+   * @param stats The statistics of the calling worker.
+   */
+  void Prefetch(  //
+      const Operation &ops,
+      WorkerStats &stats);
+
+  /**
+   * @tparam kTargetNums The numbers of target words (zero means runtime ones).
+   * @return A table of member functions specialized on each number of target words.
+   */
+  template <size_t... kTargetNums>
+  static constexpr auto MakeSpecializedTable(  //
+      std::index_sequence<kTargetNums...>)     //
+      -> std::array<SpecializedFuncs, sizeof...(kTargetNums)>;
+
+  /**
+   * @brief Execute an operation with the statistics of the calling worker.
+   *
+   * @tparam kTargetNum The number of target words (zero means a runtime one).
+   * @param ops An operation to be executed.
+   * @param stats The statistics of the calling worker.
+   * @return The number of completed operations.
+   */
+  template <size_t kTargetNum>
+  auto ExecuteOne(  //
+      const Operation &ops,
+      WorkerStats &stats)  //
+      -> size_t;
+
+  /**
+   * @brief Execute the operations of a worker in order.
+   *
+   * @tparam kTargetNum The number of target words (zero means a runtime one).
+   * @param queue The operations of a worker.
+   * @param stats The statistics of the calling worker.
+   * @return The number of completed operations.
+   */
+  template <size_t kTargetNum>
+  auto ExecuteQueue(  //
+      const std::vector<Operation> &queue,
+      WorkerStats &stats)  //
+      -> size_t;
+
+  /**
+   * @brief Compute desired values of target words in the current value mode.
+   *
+   * @tparam kTargetNum The number of target words (zero means a runtime one).
+   * @param ops An operation to be executed.
+   * @param old_vals The current values of target words.
+   * @param new_vals An output array for the desired values of target words.
+   * @retval true if target words should be swapped.
+   * @retval false if this operation does not need to modify any word.
+   */
+  template <size_t kTargetNum>
+  auto
+  ComputeNewValues(  //
+      const Operation &ops,
+      const uint64_t *old_vals,
+      uint64_t *new_vals)  //
+      -> bool
+  {
+    if (value_mode_ == kCounterValue) {
+      return ops.template ComputeNewValues<kTargetNum>(old_vals, new_vals);
+    }
+    return ComputeNewEncodedValues<kTargetNum>(ops, old_vals, new_vals);
+  }
+
+  /**
+   * @brief Decode current values, compute desired ones, and encode them.
+   *
+   * @tparam kTargetNum The number of target words (zero means a runtime one).
+   * @param ops An operation to be executed.
+   * @param old_vals The current values of target words.
+   * @param new_vals An output array for the desired values of target words.
+   * @retval true if target words should be swapped.
+   * @retval false if this operation does not need to modify any word.
+   */
+  template <size_t kTargetNum>
+  auto ComputeNewEncodedValues(  //
+      const Operation &ops,
+      const uint64_t *old_vals,
+      uint64_t *new_vals)  //
+      -> bool;
+
+  /**
+   * @param cnt A counter (or balance).
+   * @return An encoded value except for pointer mode.
+   */
+  [[nodiscard]] auto Encode(     //
+      const uint64_t cnt) const  //
+      -> uint64_t;
+
+  /**
+   * @param val A value in a target word.
+   * @return The decoded counter (or balance).
+   */
+  [[nodiscard]] auto Decode(     //
+      const uint64_t val) const  //
+      -> uint64_t;
+
+  /**
+   * @param i The index of a node.
+   * @return The address of the node.
+   */
+  [[nodiscard]] auto
+  GetNode(                   //
+      const size_t i) const  //
+      -> uint64_t *
+  {
+    return reinterpret_cast<uint64_t *>(nodes_ + i * kCacheLineSize);
+  }
+
+  /**
+   * @brief Swap target words with each implementation.
+   *
+   * @tparam kTargetNum The number of target words (zero means a runtime one).
+   * @param ops An operation to be executed.
+   * @param cm A manager for waiting before retrying failed attempts.
+   */
+  template <size_t kTargetNum>
+  void Perform(  //
+      const Operation &ops,
+      ContentionManager &cm);
+
+  /**
+   * @brief Swap target words with our PMwCAS library.
+   *
+   * @tparam kTargetNum The number of target words (zero means a runtime one).
+   * @param ops An operation to be executed.
+   * @param cm A manager for waiting before retrying failed attempts.
+   */
+  template <size_t kTargetNum>
+  void PerformPMwCAS(  //
+      const Operation &ops,
+      ContentionManager &cm);
+
+  /**
+   * @brief Protect the epoch of microsoft/pmwcas if a worker is not in it.
+   *
+   * @tparam Pool The class of a descriptor pool.
+   * @param pool A descriptor pool.
+   * @param stats The statistics of the calling worker.
+   */
+  template <class Pool>
+  void EnterEpoch(  //
+      Pool &pool,
+      WorkerStats &stats);
+
+  /**
+   * @brief Count an operation and unprotect the epoch at the end of a scope.
+   *
+   * @tparam Pool The class of a descriptor pool.
+   * @param pool A descriptor pool.
+   * @param stats The statistics of the calling worker.
+   * @param force A flag for unprotecting the epoch regardless of the scope.
+   */
+  template <class Pool>
+  void LeaveEpoch(  //
+      Pool &pool,
+      WorkerStats &stats,
+      bool force = false);
+
+  /**
+   * @brief Swap target words with microsoft/pmwcas.
+   *
+   * @tparam kTargetNum The number of target words (zero means a runtime one).
+   * @param ops An operation to be executed.
+   * @param cm A manager for waiting before retrying failed attempts.
+   */
+  template <size_t kTargetNum>
+  void PerformMicrosoftPMwCAS(  //
+      const Operation &ops,
+      ContentionManager &cm);
+
+  /**
+   * @brief Swap a single target word with the PCAS of our PMwCAS library.
+   *
+   * @param ops An operation to be executed.
+   * @param cm A manager for waiting before retrying failed attempts.
+   */
+  void PerformPCAS(  //
+      const Operation &ops,
+      ContentionManager &cm);
+
+  /**
+   * @brief Attempt to swap target words with our PMwCAS library once.
+   *
+   * @tparam kTargetNum The number of target words (zero means a runtime one).
+   * @param ops An operation to be executed.
+   * @param addrs The addresses of target words.
+   * @retval true if the operation has been completed.
+   * @retval false if the attempt has failed.
+   */
+  template <size_t kTargetNum>
+  auto TryPMwCAS(  //
+      const Operation &ops,
+      uint64_t *const *addrs)  //
+      -> bool;
+
+  /**
+   * @brief Attempt to swap target words with microsoft/pmwcas once.
+   *
+   * @tparam kTargetNum The number of target words (zero means a runtime one).
+   * @param ops An operation to be executed.
+   * @param addrs The addresses of target words.
+   * @retval true if the operation has been completed.
+   * @retval false if the attempt has failed.
+   * @note The caller must protect an epoch.
+   */
+  template <size_t kTargetNum>
+  auto TryMicrosoftPMwCAS(  //
+      const Operation &ops,
+      uint64_t *const *addrs)  //
+      -> bool;
+
+  /**
+   * @brief Swap target words while holding striped spinlocks.
+   *
+   * An operation that waits for any of its locks is counted as a conflict.
+   *
+   * @tparam kTargetNum The number of target words (zero means a runtime one).
+   * @param ops An operation to be executed.
+   */
+  template <size_t kTargetNum>
+  void PerformWithLocks(  //
+      const Operation &ops);
+
+  /**
+   * @brief Arm a preemption of the calling worker if it comes.
+   *
+   * @param addrs The addresses of target words.
+   * @param old_vals The values of target words read before an attempt.
+   * @param n The number of target words.
+   */
+  void ArmPreemption(  //
+      const uint64_t *const *addrs,
+      const uint64_t *old_vals,
+      size_t n);
+
+  /**
+   * @brief Preempt the calling worker if its armed preemption has not fired.
+   *
+   */
+  void FirePreemption();
+
+  /**
+   * @brief Attempt to swap a single target word with PCAS once.
+   *
+   * @param ops An operation to be executed.
+   * @retval true if the operation has been completed.
+   * @retval false if the attempt has failed.
+   */
+  auto TryPCAS(              //
+      const Operation &ops)  //
+      -> bool;
+
+  /**
+   * @brief Attempt to swap target words with each implementation once.
+   *
+   * @tparam kTargetNum The number of target words (zero means a runtime one).
+   * @param ops An operation to be executed.
+   * @retval true if the operation has been completed.
+   * @retval false if the attempt has failed.
+   * @note The caller must protect an epoch for microsoft/pmwcas.
+   */
+  template <size_t kTargetNum>
+  auto TrySwap(              //
+      const Operation &ops)  //
+      -> bool;
+
+  /**
+   * @brief Issue an operation after completing the oldest one in flight.
+   *
+   * An operation is issued only by prefetching its targets, so this overlaps
+   * the loads of target words with the attempts of other operations. Each
+   * attempt runs a whole PMwCAS including its flushes and fences.
+   *
+   * @tparam kTargetNum The number of target words (zero means a runtime one).
+   * @param ops An operation to be issued.
+   * @param stats The statistics of the calling thread.
+   * @return The number of completed operations.
+   */
+  template <size_t kTargetNum>
+  auto ExecuteInterleaved(  //
+      const Operation &ops,
+      WorkerStats &stats)  //
+      -> size_t;
+
+  /**
+   * @brief Attempt an operation in flight once.
+   *
+   * A failed attempt waits according to the contention manager of a worker.
+   *
+   * @tparam kTargetNum The number of target words (zero means a runtime one).
+   * @param slot A slot holding an operation in flight.
+   * @param stats The statistics of the calling thread.
+   * @retval true if the operation has been completed and the slot is freed.
+   * @retval false if the attempt has failed.
+   */
+  template <size_t kTargetNum>
+  auto Step(  //
+      InFlight &slot,
+      WorkerStats &stats)  //
+      -> bool;
+
+  /**
+   * @brief Complete all the operations in flight.
+   *
+   * @tparam kTargetNum The number of target words (zero means a runtime one).
+   * @param stats The statistics of the calling thread.
+   * @return The number of completed operations.
+   */
+  template <size_t kTargetNum>
+  auto Drain(              //
+      WorkerStats &stats)  //
+      -> size_t;
+
+  /**
+   * @param pos The position in an array.
    * @return A target address.
+   * @note Each memory block holds `words_per_group_` consecutive words, and
+   * each segment (i.e., pool file) holds a power-of-two number of blocks.
    */
-  auto GetAddr(          //
-      const size_t pos)  //
-      -> uint64_t *;
+  auto
+  GetAddr(                     //
+      const size_t pos) const  //
+      -> uint64_t *
+  {
+    const auto block = pos >> group_shift_;
+    std::byte *addr;
+    if (root_addr_ != nullptr) {
+      addr = root_addr_ + (block << shift_num_);  // a single file needs no segment table
+    } else {
+      const auto seg_mask = (1UL << seg_shift_) - 1;
+      addr = seg_addrs_[block >> seg_shift_] + ((block & seg_mask) << shift_num_);
+    }
+    return reinterpret_cast<uint64_t *>(addr + (pos & (words_per_group_ - 1)) * kWordSize);
+  }
 
   /**
    * @brief Create an array on persistent memory.
    *
    * @param pmem_dir_str A path to persistent memory for benchmarking.
    * @param array_cap The capacity of an array.
+   * @param segment_size The size of array blocks in each pool file in bytes.
    */
   void Initialize(  //
       const std::string &pmem_dir_str,
-      const size_t array_cap);
+      const size_t array_cap,
+      const size_t segment_size);
 
   /*############################################################################
    * Internal member variables
@@ -139,8 +1029,14 @@ class PMwCASTarget
   /// @brief A path to persistent memory for benchmarking.
   std::string pmem_dir_str_{};
 
-  /// @brief The pool for persistent memory.
-  PMEMobjpool *pop_{nullptr};
+  /// @brief The pools for persistent memory (one for each segment).
+  std::vector<PMEMobjpool *> pops_{};
+
+  /// @brief The paths to pool files for an array.
+  std::vector<std::string> array_paths_{};
+
+  /// @brief The capacity of an array.
+  size_t array_cap_{};
 
   /// @brief The size of each block.
   size_t block_size_{256};
@@ -148,11 +1044,107 @@ class PMwCASTarget
   /// @brief The size of the left-shift insruction instead of multiplication.
   size_t shift_num_{Log2(block_size_)};
 
-  /// @brief An array on persistent memory.
+  /// @brief The number of words co-located in each block.
+  size_t words_per_group_{1};
+
+  /// @brief The size of the right-shift instruction for computing block IDs.
+  size_t group_shift_{Log2(words_per_group_)};
+
+  /// @brief The size of the right-shift instruction for computing segment IDs.
+  size_t seg_shift_{0};
+
+  /// @brief The head addresses of array segments on persistent memory.
+  std::vector<std::byte *> seg_addrs_{};
+
+  /// @brief The head address of an array in a single file (null for multiple files).
   std::byte *root_addr_{nullptr};
 
   /// @brief A pool of PMwCAS descriptors.
   std::unique_ptr<Implementation> desc_pool_{nullptr};
+
+  /// @brief The pools of PMwCAS descriptors for the second and later processes.
+  std::vector<std::unique_ptr<Implementation>> proc_desc_pools_{};
+
+  /// @brief An encoding of values written into target words.
+  ValueMode value_mode_{kCounterValue};
+
+  /// @brief The bits set in every value in reserved-bit mode.
+  uint64_t reserved_pattern_{0};
+
+  /// @brief A pool for nodes in pointer mode.
+  PMEMobjpool *node_pop_{nullptr};
+
+  /// @brief The path to a pool file for nodes.
+  std::string node_path_{};
+
+  /// @brief The head address of nodes (one for each cache line).
+  std::byte *nodes_{nullptr};
+
+  /// @brief The number of nodes in a pool.
+  size_t node_capacity_{0};
+
+  /// @brief The next node to be reserved by workers.
+  std::atomic_size_t node_cursor_{0};
+
+  /// @brief The number of descriptors prepared in a pool.
+  size_t desc_capacity_{0};
+
+  /// @brief A policy for failed attempts.
+  ContentionPolicy contention_policy_{kNoBackoff};
+
+  /// @brief Member functions specialized on the number of target words.
+  SpecializedFuncs funcs_{};
+
+  /// @brief The number of operations in flight in each worker.
+  size_t interleave_width_{1};
+
+  /// @brief The number of operations executed by each worker in interleaved execution.
+  size_t interleave_exec_num_{0};
+
+  /// @brief Copies of the queues of all the workers for prefetching.
+  std::vector<std::vector<Operation>> prefetch_queues_{};
+
+  /// @brief The number of operations to look ahead for prefetching.
+  size_t prefetch_distance_{0};
+
+  /// @brief The number of attempts between preemptions of each worker.
+  size_t preempt_interval_{0};
+
+  /// @brief The length of each preemption in microseconds.
+  size_t preempt_sleep_us_{0};
+
+  /// @brief The number of operations in each epoch (zero means a worker run).
+  size_t epoch_scope_{1};
+
+  /// @brief A flag for sampling the lag of descriptor reclamation.
+  bool measure_epoch_lag_{false};
+
+  /// @brief A flag for measuring the latency of each operation type.
+  bool measure_type_latency_{false};
+
+  /// @brief A flag for attributing latency to contention levels.
+  bool measure_contention_{false};
+
+  /// @brief A flag for recording latency in TSC cycles.
+  bool measure_tsc_latency_{false};
+
+  /// @brief A latency histogram in TSC cycles shared by all the workers.
+  HDRHistogram tsc_hist_{};
+
+  /// @brief The unique ID of this object for detecting registered workers.
+  size_t id_{0};
+
+  /// @brief A mutex for registering workers.
+  std::mutex stats_mtx_{};
+
+  /// @brief The statistics of all the workers.
+  std::vector<std::unique_ptr<WorkerStats>> stats_{};
+
+  /// @brief The ID of a target object that the current statistics belong to.
+  inline static thread_local size_t tls_target_id_{0};
+
+  /// @brief The statistics of the calling thread.
+  inline static thread_local WorkerStats *tls_stats_{nullptr};
 };
 
 #endif  // PMWCAS_BENCHMARK_ARRAY_PMWCAS_TARGET_HPP
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMWCAS_BENCHMARK_PROCESS_BARRIER_HPP
+#define PMWCAS_BENCHMARK_PROCESS_BARRIER_HPP
+
+// C++ standard libraries
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+// system headers
+#include <immintrin.h>
+#include <sys/mman.h>
+
+// local sources
+#include "common.hpp"
+
+/**
+ * @brief A start barrier and result slots shared among forked processes.
+ *
+ * The shared region is mapped anonymously before `fork`, so child processes
+ * inherit it at the same address.
+ *
+ * @tparam Result A trivially copyable class for the results of each process.
+ */
+template <class Result>
+class ProcessBarrier
+{
+ public:
+  /*############################################################################
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Construct a new ProcessBarrier object.
+   *
+   * @param process_num The number of processes.
+   * @param participant_num The number of threads waiting at the barrier.
+   */
+  ProcessBarrier(  //
+      const size_t process_num,
+      const size_t participant_num)
+      : participant_num_{participant_num},
+        region_size_{kCacheLineSize + process_num * sizeof(Result)}
+  {
+    static_assert(std::is_trivially_copyable_v<Result>);
+
+    region_ = mmap(nullptr, region_size_, PROT_READ | PROT_WRITE,  //
+                   MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (region_ == MAP_FAILED) {
+      throw std::runtime_error{"Failed to map a region shared among processes."};
+    }
+
+    auto *head = reinterpret_cast<std::byte *>(region_);
+    arrived_ = new (head) std::atomic_size_t{0};
+    results_ = reinterpret_cast<Result *>(head + kCacheLineSize);
+    for (size_t i = 0; i < process_num; ++i) {
+      new (results_ + i) Result{};
+    }
+  }
+
+  ProcessBarrier(const ProcessBarrier &) = delete;
+  ProcessBarrier(ProcessBarrier &&) = delete;
+
+  ProcessBarrier &operator=(const ProcessBarrier &obj) = delete;
+  ProcessBarrier &operator=(ProcessBarrier &&) = delete;
+
+  /*############################################################################
+   * Public destructors
+   *##########################################################################*/
+
+  /**
+   * @brief Destroy the ProcessBarrier object.
+   *
+   */
+  ~ProcessBarrier()
+  {
+    munmap(region_, region_size_);
+  }
+
+  /*############################################################################
+   * Public utilities
+   *##########################################################################*/
+
+  /**
+   * @brief Block the calling thread until all the participants arrive.
+   *
+   */
+  void
+  Wait()
+  {
+    arrived_->fetch_add(1, std::memory_order_acq_rel);
+    while (arrived_->load(std::memory_order_acquire) < participant_num_) {
+      _mm_pause();
+    }
+  }
+
+  /**
+   * @param process_id The ID of a process.
+   * @return The result slot of the process.
+   */
+  auto
+  GetResult(                          //
+      const size_t process_id) const  //
+      -> Result &
+  {
+    return results_[process_id];
+  }
+
+ private:
+  /*############################################################################
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief The number of threads waiting at the barrier.
+  size_t participant_num_{0};
+
+  /// @brief The size of a shared region in bytes.
+  size_t region_size_{0};
+
+  /// @brief The head address of a shared region.
+  void *region_{nullptr};
+
+  /// @brief The number of arrived threads.
+  std::atomic_size_t *arrived_{nullptr};
+
+  /// @brief The result slots of processes.
+  Result *results_{nullptr};
+};
+
+#endif  // PMWCAS_BENCHMARK_PROCESS_BARRIER_HPP
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMWCAS_BENCHMARK_QUEUE_OPERATION_ENGINE_HPP
+#define PMWCAS_BENCHMARK_QUEUE_OPERATION_ENGINE_HPP
+
+// C++ standard libraries
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief An operation on a persistent queue.
+ *
+ */
+struct QueueOperation {
+  /// @brief Enqueue an element if true, dequeue an element otherwise.
+  bool is_enqueue{true};
+};
+
+class QueueOperationEngine
+{
+ public:
+  /*############################################################################
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Construct a new QueueOperationEngine object.
+   *
+   * @param producer_num The number of workers that only enqueue elements (zero
+   * means that every worker alternates enqueue and dequeue).
+   */
+  explicit QueueOperationEngine(  //
+      const size_t producer_num = 0)
+      : producer_num_{producer_num}
+  {
+  }
+
+  /*############################################################################
+   * Public utility functions
+   *##########################################################################*/
+
+  /**
+   * @brief Generate operations for the next worker.
+   *
+   * The first `producer_num` calls create producers and the rest create
+   * consumers that only dequeue elements.
+   *
+   * @param n The number of operations to be executed by each worker.
+   * @return A sequence of queue operations.
+   */
+  auto
+  Generate(  //
+      const size_t n,
+      [[maybe_unused]] const size_t random_seed)  //
+      -> std::vector<QueueOperation>
+  {
+    std::vector<QueueOperation> operations(n);
+    if (producer_num_ == 0) {
+      for (size_t i = 0; i < n; ++i) {
+        operations[i].is_enqueue = (i % 2 == 0);
+      }
+    } else {
+      const auto id = next_worker_->fetch_add(1, std::memory_order_relaxed);
+      for (auto &ops : operations) {
+        ops.is_enqueue = (id < producer_num_);
+      }
+    }
+    return operations;
+  }
+
+ private:
+  /*############################################################################
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief The number of workers that only enqueue elements.
+  size_t producer_num_{0};
+
+  /// @brief The next worker to be assigned a role (shared among copies of this engine).
+  std::shared_ptr<std::atomic_size_t> next_worker_{std::make_shared<std::atomic_size_t>(0)};
+};
+
+#endif  // PMWCAS_BENCHMARK_QUEUE_OPERATION_ENGINE_HPP
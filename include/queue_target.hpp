@@ -0,0 +1,324 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMWCAS_BENCHMARK_QUEUE_TARGET_HPP
+#define PMWCAS_BENCHMARK_QUEUE_TARGET_HPP
+
+// C++ standard libraries
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// external system libraries
+#include <libpmemobj.h>
+
+// local sources
+#include "common.hpp"
+#include "contention_manager.hpp"
+#include "queue_operation_engine.hpp"
+
+/**
+ * @brief The numbers of executed queue operations by their results.
+ *
+ */
+struct QueueStats {
+  /// @brief The number of enqueued elements.
+  size_t enqueue_num{0};
+
+  /// @brief The number of dequeued elements.
+  size_t dequeue_num{0};
+
+  /// @brief The number of enqueue operations that found a full queue.
+  size_t full_num{0};
+
+  /// @brief The number of dequeue operations that found an empty queue.
+  size_t empty_num{0};
+
+  /// @brief The sum of enqueued elements.
+  uint64_t enqueued_sum{0};
+
+  /// @brief The sum of dequeued elements.
+  uint64_t dequeued_sum{0};
+};
+
+/**
+ * @brief A bounded MPMC queue on persistent memory built with 2-word MwCAS.
+ *
+ * The head and tail are monotonic counters in separate cache lines, and the
+ * i-th element is stored in the `(i % capacity)`-th slot of a ring buffer.
+ * Each enqueue swaps the tail and an empty slot, and each dequeue swaps the
+ * head and an occupied slot in one MwCAS, so a queue needs neither locks nor
+ * recovery logs. Since an empty slot is represented by zero, elements are
+ * always non-zero.
+ *
+ * @tparam Implementation A certain implementation of MwCAS algorithms.
+ */
+template <class Implementation>
+class QueueTarget
+{
+ public:
+  /*############################################################################
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Construct a new QueueTarget object.
+   *
+   * @param pmem_dir_str A path to persistent memory for benchmarking.
+   * @param capacity The number of slots in a ring buffer (a power of two).
+   * @param prefill_num The number of elements enqueued before benchmarking.
+   */
+  QueueTarget(  //
+      const std::string &pmem_dir_str,
+      const size_t capacity,
+      const size_t prefill_num);
+
+  QueueTarget(const QueueTarget &) = delete;
+  QueueTarget(QueueTarget &&) = delete;
+
+  QueueTarget &operator=(const QueueTarget &obj) = delete;
+  QueueTarget &operator=(QueueTarget &&) = delete;
+
+  /*############################################################################
+   * Public destructors
+   *##########################################################################*/
+
+  /**
+   * @brief Destroy the QueueTarget object.
+   *
+   */
+  ~QueueTarget();
+
+  /*############################################################################
+   * Setup/Teardown for workers
+   *##########################################################################*/
+
+  /**
+   * @brief Register the calling thread as a worker.
+   *
+   */
+  void SetUpForWorker();
+
+  constexpr void
+  TearDownForWorker()
+  {
+    // do nothing
+  }
+
+  /*############################################################################
+   * Public utilities
+   *##########################################################################*/
+
+  /**
+   * @param policy A policy for failed MwCAS attempts.
+   */
+  void
+  SetContentionPolicy(  //
+      const ContentionPolicy policy)
+  {
+    contention_policy_ = policy;
+  }
+
+  /**
+   * @brief Enqueue or dequeue an element once.
+   *
+   * An operation that finds a full or empty queue is completed without
+   * retrying, so producers and consumers never wait for each other. Such an
+   * operation does not swap any word, so it is not counted in throughput.
+   *
+   * @param ops An operation to be executed.
+   * @retval 1 if an element is enqueued or dequeued.
+   * @retval 0 if a queue is full or empty.
+   */
+  auto Execute(                   //
+      const QueueOperation &ops)  //
+      -> size_t;
+
+  /**
+   * @return The numbers of executed operations summed over all the workers.
+   */
+  [[nodiscard]] auto GetStats() const  //
+      -> QueueStats;
+
+  /**
+   * @brief Check the elements left in a queue against executed operations.
+   *
+   * Slots in [head, tail) must be occupied and the others must be empty, and
+   * the sum of elements must be equal to prefilled, enqueued, and dequeued
+   * ones. This must be called after all the workers have finished.
+   *
+   * @retval true if the queue is consistent.
+   * @retval false otherwise.
+   */
+  [[nodiscard]] auto Verify() const  //
+      -> bool;
+
+ private:
+  /*############################################################################
+   * Internal constants
+   *##########################################################################*/
+
+  /// @brief The number of bits for sequence numbers in each element.
+  static constexpr size_t kSeqBits = 40;
+
+  /// @brief A value of empty slots.
+  static constexpr uint64_t kEmpty = 0;
+
+  /*############################################################################
+   * Internal classes
+   *##########################################################################*/
+
+  /**
+   * @brief Local states of each worker padded to avoid false sharing.
+   *
+   */
+  struct alignas(kCacheLineSize) Worker {
+    /// @brief A prefix of elements unique to this worker.
+    uint64_t prefix{0};
+
+    /// @brief The sequence number of the last enqueued element.
+    uint64_t seq{0};
+
+    /// @brief The numbers of executed operations.
+    QueueStats stats{};
+
+    /// @brief A manager for failed attempts.
+    ContentionManager cm{};
+  };
+
+  /*############################################################################
+   * Internal utilities
+   *##########################################################################*/
+
+  /**
+   * @param w The calling worker.
+   * @param val An element to be enqueued.
+   * @retval true if the element is enqueued.
+   * @retval false if the queue is full.
+   */
+  auto Enqueue(  //
+      Worker &w,
+      uint64_t val)  //
+      -> bool;
+
+  /**
+   * @param w The calling worker.
+   * @param val A dequeued element.
+   * @retval true if an element is dequeued.
+   * @retval false if the queue is empty.
+   */
+  auto Dequeue(  //
+      Worker &w,
+      uint64_t &val)  //
+      -> bool;
+
+  /**
+   * @param addr The address of a word.
+   * @return The current value of the word.
+   */
+  auto Read(           //
+      uint64_t *addr)  //
+      -> uint64_t;
+
+  /**
+   * @brief Swap two words atomically if both have expected values.
+   *
+   * @param addr_1 The address of a head or tail (must precede `addr_2`).
+   * @param old_1 An expected value of `addr_1`.
+   * @param new_1 A desired value of `addr_1`.
+   * @param addr_2 The address of a slot.
+   * @param old_2 An expected value of `addr_2`.
+   * @param new_2 A desired value of `addr_2`.
+   * @retval true if both words are swapped.
+   * @retval false otherwise.
+   */
+  auto TrySwap(  //
+      uint64_t *addr_1,
+      uint64_t old_1,
+      uint64_t new_1,
+      uint64_t *addr_2,
+      uint64_t old_2,
+      uint64_t new_2)  //
+      -> bool;
+
+  /**
+   * @param addr The address of a head, tail, or slot.
+   * @return The position of a word for computing its lock stripe.
+   */
+  [[nodiscard]] auto GetPosition(  //
+      const uint64_t *addr) const  //
+      -> size_t;
+
+  /**
+   * @param cnt A head or tail counter.
+   * @return The address of a slot for the counter.
+   */
+  [[nodiscard]] auto
+  GetSlot(                       //
+      const uint64_t cnt) const  //
+      -> uint64_t *
+  {
+    return slots_ + (cnt & (capacity_ - 1));
+  }
+
+  /*############################################################################
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief A path to persistent memory for benchmarking.
+  std::string pmem_dir_str_{};
+
+  /// @brief The number of slots in a ring buffer.
+  size_t capacity_{1};
+
+  /// @brief The number of elements enqueued before benchmarking.
+  size_t prefill_num_{0};
+
+  /// @brief The sum of elements enqueued before benchmarking.
+  uint64_t prefill_sum_{0};
+
+  /// @brief A pool for persistent memory.
+  PMEMobjpool *pop_{nullptr};
+
+  /// @brief The address of a head counter.
+  uint64_t *head_{nullptr};
+
+  /// @brief The address of a tail counter.
+  uint64_t *tail_{nullptr};
+
+  /// @brief The head address of slots.
+  uint64_t *slots_{nullptr};
+
+  /// @brief A pool of descriptors or locks.
+  std::unique_ptr<Implementation> desc_pool_{nullptr};
+
+  /// @brief A policy for failed MwCAS attempts.
+  ContentionPolicy contention_policy_{kNoBackoff};
+
+  /// @brief A mutex for registering workers.
+  std::mutex worker_mtx_{};
+
+  /// @brief The local states of all the workers.
+  std::vector<std::unique_ptr<Worker>> workers_{};
+
+  /// @brief The local states of the calling thread.
+  inline static thread_local Worker *tls_worker_{nullptr};
+};
+
+#endif  // PMWCAS_BENCHMARK_QUEUE_TARGET_HPP
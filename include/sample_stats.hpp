@@ -0,0 +1,217 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMWCAS_BENCHMARK_SAMPLE_STATS_HPP
+#define PMWCAS_BENCHMARK_SAMPLE_STATS_HPP
+
+// C++ standard libraries
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Summary statistics of a metric measured in repeated runs.
+ *
+ */
+class SampleStats
+{
+ public:
+  /*############################################################################
+   * Public utilities
+   *##########################################################################*/
+
+  /**
+   * @brief Add a measured value.
+   *
+   * @param val A value of one repetition.
+   */
+  void
+  Add(  //
+      const double val)
+  {
+    samples_.emplace_back(val);
+  }
+
+  /**
+   * @return The number of samples.
+   */
+  [[nodiscard]] auto
+  GetCount() const  //
+      -> size_t
+  {
+    return samples_.size();
+  }
+
+  /**
+   * @return The arithmetic mean of samples.
+   */
+  [[nodiscard]] auto
+  GetMean() const  //
+      -> double
+  {
+    if (samples_.empty()) return 0;
+
+    double sum = 0;
+    for (const auto val : samples_) {
+      sum += val;
+    }
+    return sum / samples_.size();
+  }
+
+  /**
+   * @return The unbiased sample variance (zero for less than two samples).
+   */
+  [[nodiscard]] auto
+  GetVariance() const  //
+      -> double
+  {
+    const auto n = samples_.size();
+    if (n < 2) return 0;
+
+    const auto mean = GetMean();
+    double sum = 0;
+    for (const auto val : samples_) {
+      sum += (val - mean) * (val - mean);
+    }
+    return sum / (n - 1);
+  }
+
+  /**
+   * @return The sample standard deviation (zero for less than two samples).
+   */
+  [[nodiscard]] auto
+  GetStdDev() const  //
+      -> double
+  {
+    return std::sqrt(GetVariance());
+  }
+
+  /**
+   * @return The median of samples.
+   */
+  [[nodiscard]] auto
+  GetMedian() const  //
+      -> double
+  {
+    const auto n = samples_.size();
+    if (n == 0) return 0;
+
+    auto sorted = samples_;
+    std::sort(sorted.begin(), sorted.end());
+    return (n % 2 == 1) ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+  }
+
+  /**
+   * @return The half width of a 95% confidence interval of the mean based on
+   * Student's t-distribution (zero for less than two samples).
+   */
+  [[nodiscard]] auto
+  GetCIHalfWidth() const  //
+      -> double
+  {
+    const auto n = samples_.size();
+    if (n < 2) return 0;
+    return GetTValue(n - 1) * GetStdDev() / std::sqrt(n);
+  }
+
+  /**
+   * @return The half width of a 95% confidence interval relative to the mean.
+   */
+  [[nodiscard]] auto
+  GetRelativeCI() const  //
+      -> double
+  {
+    const auto mean = GetMean();
+    return (mean == 0) ? 0 : GetCIHalfWidth() / std::abs(mean);
+  }
+
+  /**
+   * @brief Test whether two means differ with Welch's t-test at the 5% level.
+   *
+   * If either has less than two samples, any difference of means is regarded
+   * as significant because variance cannot be estimated.
+   *
+   * @param a Samples of a baseline.
+   * @param b Samples to be compared.
+   * @retval true if the means differ significantly.
+   * @retval false otherwise.
+   */
+  static auto
+  DiffersSignificantly(  //
+      const SampleStats &a,
+      const SampleStats &b)  //
+      -> bool
+  {
+    const auto na = a.GetCount();
+    const auto nb = b.GetCount();
+    const auto diff = std::abs(a.GetMean() - b.GetMean());
+    if (na < 2 || nb < 2) return diff > 0;
+
+    const auto va = a.GetVariance() / na;
+    const auto vb = b.GetVariance() / nb;
+    const auto se2 = va + vb;
+    if (se2 == 0) return diff > 0;
+
+    // use the Welch-Satterthwaite degrees of freedom rounded down
+    const auto df = se2 * se2 / (va * va / (na - 1) + vb * vb / (nb - 1));
+    const auto t = diff / std::sqrt(se2);
+    return t > GetTValue(std::max<size_t>(static_cast<size_t>(df), 1));
+  }
+
+  /**
+   * @param df Degrees of freedom.
+   * @return The 97.5th percentile of Student's t-distribution (for two-sided 95%).
+   */
+  static constexpr auto
+  GetTValue(            //
+      const size_t df)  //
+      -> double
+  {
+    constexpr double kTable[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,  // 1-10
+        2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,  // 11-20
+        2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,  // 21-30
+    };
+    constexpr size_t kTableSize = sizeof(kTable) / sizeof(kTable[0]);
+
+    // larger degrees of freedom are interpolated linearly in 1/df (zero for normal)
+    constexpr double kTailInv[] = {1.0 / 30, 1.0 / 40, 1.0 / 60, 1.0 / 120, 0};
+    constexpr double kTailTable[] = {2.042, 2.021, 2.000, 1.980, 1.960};
+    constexpr size_t kTailSize = sizeof(kTailTable) / sizeof(kTailTable[0]);
+
+    if (df == 0) return 0;
+    if (df <= kTableSize) return kTable[df - 1];
+
+    const auto inv = 1.0 / df;
+    size_t i = 1;
+    while (i < kTailSize - 1 && inv < kTailInv[i]) {
+      ++i;
+    }
+    const auto ratio = (inv - kTailInv[i]) / (kTailInv[i - 1] - kTailInv[i]);
+    return kTailTable[i] + ratio * (kTailTable[i - 1] - kTailTable[i]);
+  }
+
+ private:
+  /*############################################################################
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief Measured values.
+  std::vector<double> samples_{};
+};
+
+#endif  // PMWCAS_BENCHMARK_SAMPLE_STATS_HPP
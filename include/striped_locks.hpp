@@ -0,0 +1,173 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMWCAS_BENCHMARK_STRIPED_LOCKS_HPP
+#define PMWCAS_BENCHMARK_STRIPED_LOCKS_HPP
+
+// C++ standard libraries
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+
+// system headers
+#include <immintrin.h>
+#include <sys/mman.h>
+
+// local sources
+#include "common.hpp"
+
+/**
+ * @brief A table of spinlocks for a blocking MwCAS baseline.
+ *
+ * Each target position is mapped to one of power-of-two stripes. Callers must
+ * acquire stripes in ascending order to avoid deadlocks. The stripes are
+ * mapped in a region shared with forked processes, so workers in different
+ * processes exclude each other.
+ */
+class StripedLocks
+{
+ public:
+  /*############################################################################
+   * Public constants
+   *##########################################################################*/
+
+  /// @brief The default number of stripes.
+  static constexpr size_t kDefaultStripeNum = 1UL << 16UL;
+
+  /*############################################################################
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Construct a new StripedLocks object.
+   *
+   * @param stripe_num The number of stripes (must be a power of two).
+   */
+  explicit StripedLocks(  //
+      const size_t stripe_num = kDefaultStripeNum)
+      : mask_{stripe_num - 1}, region_size_{stripe_num * sizeof(Spinlock)}
+  {
+    auto *region = mmap(nullptr, region_size_, PROT_READ | PROT_WRITE,  //
+                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+      throw std::runtime_error{"Failed to map a region for striped locks."};
+    }
+    locks_ = reinterpret_cast<Spinlock *>(region);
+    for (size_t i = 0; i < stripe_num; ++i) {
+      new (locks_ + i) Spinlock{};
+    }
+  }
+
+  StripedLocks(const StripedLocks &) = delete;
+  StripedLocks(StripedLocks &&) = delete;
+
+  StripedLocks &operator=(const StripedLocks &obj) = delete;
+  StripedLocks &operator=(StripedLocks &&) = delete;
+
+  /*############################################################################
+   * Public destructors
+   *##########################################################################*/
+
+  /**
+   * @brief Destroy the StripedLocks object.
+   *
+   */
+  ~StripedLocks()
+  {
+    munmap(locks_, region_size_);
+  }
+
+  /*############################################################################
+   * Public utilities
+   *##########################################################################*/
+
+  /**
+   * @param pos A target position in an array.
+   * @return The stripe that protects the position.
+   */
+  [[nodiscard]] constexpr auto
+  GetStripe(                   //
+      const size_t pos) const  //
+      -> size_t
+  {
+    return pos & mask_;
+  }
+
+  /**
+   * @brief Acquire a stripe with a test-and-test-and-set spinlock.
+   *
+   * @param stripe A stripe to be locked.
+   * @retval true if the stripe was held by another thread (i.e., contended).
+   * @retval false otherwise.
+   */
+  auto
+  Lock(  //
+      const size_t stripe)  //
+      -> bool
+  {
+    auto &locked = locks_[stripe].locked;
+    if (!locked.exchange(true, std::memory_order_acquire)) return false;
+
+    do {
+      while (locked.load(std::memory_order_relaxed)) {
+        _mm_pause();
+      }
+    } while (locked.exchange(true, std::memory_order_acquire));
+    return true;
+  }
+
+  /**
+   * @brief Release a stripe.
+   *
+   * @param stripe A stripe to be unlocked.
+   */
+  void
+  Unlock(  //
+      const size_t stripe)
+  {
+    locks_[stripe].locked.store(false, std::memory_order_release);
+  }
+
+ private:
+  /*############################################################################
+   * Internal classes
+   *##########################################################################*/
+
+  /**
+   * @brief A spinlock padded to avoid false sharing.
+   *
+   */
+  struct alignas(kCacheLineSize) Spinlock {
+    /// @brief A flag for indicating that the stripe is locked.
+    std::atomic_bool locked{false};
+  };
+
+  /*############################################################################
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief A bit mask for computing stripes.
+  size_t mask_{kDefaultStripeNum - 1};
+
+  /// @brief The size of a shared region for stripes in bytes.
+  size_t region_size_{0};
+
+  /// @brief The spinlocks of stripes.
+  Spinlock *locks_{nullptr};
+};
+
+#endif  // PMWCAS_BENCHMARK_STRIPED_LOCKS_HPP
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMWCAS_BENCHMARK_TSC_CLOCK_HPP
+#define PMWCAS_BENCHMARK_TSC_CLOCK_HPP
+
+// C++ standard libraries
+#include <chrono>
+#include <cstdint>
+
+// system headers
+#include <cpuid.h>
+#include <x86intrin.h>
+
+/**
+ * @brief A clock based on the time stamp counter of x86 processors.
+ *
+ * Reading the counter costs a few dozen cycles without a system call, so it
+ * barely distorts the latency of sub-microsecond operations. Cycles are
+ * converted into nanoseconds with a rate calibrated against `steady_clock`.
+ */
+class TSCClock
+{
+ public:
+  /*############################################################################
+   * Public constants
+   *##########################################################################*/
+
+  /// @brief The default duration of calibration.
+  static constexpr auto kDefaultCalibration = std::chrono::milliseconds{100};
+
+  /*############################################################################
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Construct a new TSCClock object with calibration.
+   *
+   * @param duration The duration of calibration.
+   */
+  explicit TSCClock(  //
+      const std::chrono::nanoseconds duration = kDefaultCalibration)
+  {
+    using Clock_t = std::chrono::steady_clock;
+
+    // spin rather than sleep so that the core keeps its frequency
+    const auto &begin = Clock_t::now();
+    const auto begin_cycles = Now();
+    auto end = Clock_t::now();
+    while (end - begin < duration) {
+      end = Clock_t::now();
+    }
+    const auto end_cycles = Now();
+
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+    cycles_per_ns_ = static_cast<double>(end_cycles - begin_cycles) / ns;
+  }
+
+  /*############################################################################
+   * Public utilities
+   *##########################################################################*/
+
+  /**
+   * @brief Read the time stamp counter.
+   *
+   * `rdtscp` waits for preceding instructions, and the following `lfence`
+   * prevents succeeding ones from starting before the read.
+   *
+   * @return The current cycles.
+   */
+  static auto
+  Now()  //
+      -> uint64_t
+  {
+    uint32_t aux{};
+    const auto cycles = __rdtscp(&aux);
+    _mm_lfence();
+    return cycles;
+  }
+
+  /**
+   * @retval true if the counter ticks at a constant rate in all the states.
+   * @retval false otherwise.
+   */
+  static auto
+  IsInvariant()  //
+      -> bool
+  {
+    constexpr uint32_t kAdvancedPowerLeaf = 0x80000007;
+    constexpr uint32_t kInvariantTSCBit = 1U << 8U;
+
+    uint32_t eax{}, ebx{}, ecx{}, edx{};
+    if (__get_cpuid(kAdvancedPowerLeaf, &eax, &ebx, &ecx, &edx) == 0) return false;
+    return (edx & kInvariantTSCBit) != 0;
+  }
+
+  /**
+   * @return The calibrated number of cycles per nanosecond.
+   */
+  [[nodiscard]] constexpr auto
+  GetCyclesPerNano() const  //
+      -> double
+  {
+    return cycles_per_ns_;
+  }
+
+  /**
+   * @param cycles Elapsed cycles.
+   * @return Elapsed nanoseconds.
+   */
+  [[nodiscard]] constexpr auto
+  ToNanos(                          //
+      const uint64_t cycles) const  //
+      -> uint64_t
+  {
+    return static_cast<uint64_t>(cycles / cycles_per_ns_);
+  }
+
+ private:
+  /*############################################################################
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief The number of cycles per nanosecond.
+  double cycles_per_ns_{1.0};
+};
+
+#endif  // PMWCAS_BENCHMARK_TSC_CLOCK_HPP
@@ -18,10 +18,15 @@
 #define PMWCAS_BENCHMARK_CLO_VALIDATORS_HPP
 
 // C++ standard libraries
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 #include <string>
 
+// external system libraries
+#include <libpmemobj.h>
+
 /*##############################################################################
  * Validators for gflags
  *############################################################################*/
@@ -70,6 +75,91 @@ ValidateBlockSize(  //
   return true;
 }
 
+template <class UInt>
+static auto
+ValidatePowerOfTwo(  //
+    const char *flagname,
+    const UInt value)  //
+    -> bool
+{
+  if (value == 0 || (value & (value - 1))) {
+    std::cerr << "A value must be the exponential in two: " << flagname << "\n";
+    return false;
+  }
+  return true;
+}
+
+template <class UInt>
+static auto
+ValidateZeroOrPowerOfTwo(  //
+    const char *flagname,
+    const UInt value)  //
+    -> bool
+{
+  if (value == 0) return true;
+  return ValidatePowerOfTwo(flagname, value);
+}
+
+template <class UInt>
+static auto
+ValidatePrefetchDistance(  //
+    const char *flagname,
+    const UInt value)  //
+    -> bool
+{
+  // targets fetched too early are evicted before their operations start
+  constexpr UInt kMaxDistance = 1024;
+  if (value <= kMaxDistance) return true;
+
+  std::cerr << "A value must be at most " << kMaxDistance << " for " << flagname << "\n";
+  return false;
+}
+
+template <class UInt>
+static auto
+ValidateUInt32(  //
+    const char *flagname,
+    const UInt value)  //
+    -> bool
+{
+  if (value <= std::numeric_limits<uint32_t>::max()) return true;
+
+  std::cerr << "A value must fit in 32 bits for " << flagname << "\n";
+  return false;
+}
+
+/**
+ * @retval true if a pool size in MiB is zero (i.e., default) or satisfies PMEMOBJ_MIN_POOL.
+ * @retval false otherwise.
+ */
+static auto
+ValidateDescPoolSize(  //
+    const char *flagname,
+    const uint64_t value)  //
+    -> bool
+{
+  constexpr uint64_t kMiB = 1UL << 20UL;
+  constexpr uint64_t kMinPoolSize = (PMEMOBJ_MIN_POOL + kMiB - 1) / kMiB;
+  constexpr uint64_t kMaxPoolSize = std::numeric_limits<uint64_t>::max() / kMiB;
+  if (value == 0 || (value >= kMinPoolSize && value <= kMaxPoolSize)) return true;
+
+  std::cerr << "A value must be zero or in [" << kMinPoolSize << ", " << kMaxPoolSize
+            << "] MiB for " << flagname << "\n";
+  return false;
+}
+
+static auto
+ValidateRatio(  //
+    const char *flagname,
+    const double value)  //
+    -> bool
+{
+  if (value >= 0 && value <= 1) return true;
+
+  std::cerr << "A value must be in [0, 1] for " << flagname << "\n";
+  return false;
+}
+
 static auto
 ValidateRandomSeed(  //
     [[maybe_unused]] const char *flagname,
@@ -87,4 +177,89 @@ ValidateRandomSeed(  //
   return true;
 }
 
+static auto
+ValidateWorkload(  //
+    [[maybe_unused]] const char *flagname,
+    const std::string &workload)  //
+    -> bool
+{
+  if (workload == "increment" || workload == "transfer") return true;
+
+  std::cerr << "A workload must be \"increment\" or \"transfer\"\n";
+  return false;
+}
+
+static auto
+ValidateValueMode(  //
+    [[maybe_unused]] const char *flagname,
+    const std::string &mode)  //
+    -> bool
+{
+  if (mode == "counter" || mode == "pointer" || mode == "random" || mode == "reserved") {
+    return true;
+  }
+
+  std::cerr << "A value mode must be counter, pointer, random, or reserved\n";
+  return false;
+}
+
+static auto
+ValidateContentionManager(  //
+    [[maybe_unused]] const char *flagname,
+    const std::string &policy)  //
+    -> bool
+{
+  if (policy == "none" || policy == "exponential" || policy == "randomized"
+      || policy == "adaptive") {
+    return true;
+  }
+
+  std::cerr << "A contention manager must be none, exponential, randomized, or adaptive\n";
+  return false;
+}
+
+static auto
+ValidatePrimitive(  //
+    [[maybe_unused]] const char *flagname,
+    const std::string &primitive)  //
+    -> bool
+{
+  if (primitive == "pload" || primitive == "pcas" || primitive == "pmwcas"
+      || primitive == "microsoft_pmwcas" || primitive == "epoch" || primitive == "flush_fence") {
+    return true;
+  }
+
+  std::cerr << "A primitive must be pload, pcas, pmwcas, microsoft_pmwcas, epoch, or "
+               "flush_fence\n";
+  return false;
+}
+
+static auto
+ValidateSharing(  //
+    [[maybe_unused]] const char *flagname,
+    const std::string &sharing)  //
+    -> bool
+{
+  if (sharing == "none" || sharing == "false" || sharing == "true") return true;
+
+  std::cerr << "A sharing mode must be none, false, or true\n";
+  return false;
+}
+
+static auto
+ValidatePersistMode(  //
+    [[maybe_unused]] const char *flagname,
+    const std::string &mode)  //
+    -> bool
+{
+  if (mode == "native") return true;
+#ifdef PMWCAS_BENCH_EMULATE_PMEM
+  if (mode == "clflush" || mode == "clflushopt" || mode == "clwb" || mode == "eadr") return true;
+  std::cerr << "A persistence mode must be native, clflush, clflushopt, clwb, or eadr\n";
+#else
+  std::cerr << "Persistence modes require a build with PMWCAS_BENCH_EMULATE_PMEM=ON\n";
+#endif
+  return false;
+}
+
 #endif  // PMWCAS_BENCHMARK_CLO_VALIDATORS_HPP
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMWCAS_BENCHMARK_VALUE_CODEC_HPP
+#define PMWCAS_BENCHMARK_VALUE_CODEC_HPP
+
+// C++ standard libraries
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief A list of encodings of values written into target words.
+ *
+ * Each word logically holds a counter (or a balance), and every mode encodes
+ * it reversibly so that the sum of an array can be verified in any mode.
+ */
+enum ValueMode {
+  /// @brief Write counters as they are.
+  kCounterValue,
+  /// @brief Write the addresses of nodes holding counters.
+  kPointerValue,
+  /// @brief Write counters scrambled over 62 bits.
+  kRandomValue,
+  /// @brief Write counters with the highest bits that a competitor leaves free.
+  kReservedValue,
+};
+
+/*##############################################################################
+ * Global constants
+ *############################################################################*/
+
+/// @brief The number of bits used by random values.
+constexpr size_t kRandomValueBits = 62;
+
+/// @brief A mask for the bits of random values.
+constexpr uint64_t kRandomValueMask = (1UL << kRandomValueBits) - 1;
+
+/// @brief The number of free bits set in each reserved-bit pattern.
+constexpr size_t kReservedPatternBits = 2;
+
+/*##############################################################################
+ * Global utilities
+ *############################################################################*/
+
+/**
+ * @param odd An odd number.
+ * @return The multiplicative inverse of the number modulo 2^64.
+ */
+constexpr auto
+GetMultiplicativeInverse(  //
+    const uint64_t odd)    //
+    -> uint64_t
+{
+  // each Newton step doubles the number of correct low bits
+  uint64_t inv = odd;
+  for (size_t i = 0; i < 5; ++i) {
+    inv *= 2 - odd * inv;
+  }
+  return inv;
+}
+
+/**
+ * @brief Scramble a counter into a 62-bit value bijectively.
+ *
+ * @param cnt A counter.
+ * @return A value that looks random (zero is mapped to zero).
+ */
+constexpr auto
+EncodeRandomValue(       //
+    const uint64_t cnt)  //
+    -> uint64_t
+{
+  constexpr uint64_t kMul1 = 0x9E3779B97F4A7C15UL;
+  constexpr uint64_t kMul2 = 0xBF58476D1CE4E5B9UL;
+  constexpr size_t kShift = kRandomValueBits / 2;
+
+  auto val = (cnt * kMul1) & kRandomValueMask;
+  val ^= val >> kShift;
+  return (val * kMul2) & kRandomValueMask;
+}
+
+/**
+ * @param val A value given by `EncodeRandomValue()`.
+ * @return The original counter.
+ */
+constexpr auto
+DecodeRandomValue(       //
+    const uint64_t val)  //
+    -> uint64_t
+{
+  constexpr uint64_t kInv1 = GetMultiplicativeInverse(0x9E3779B97F4A7C15UL);
+  constexpr uint64_t kInv2 = GetMultiplicativeInverse(0xBF58476D1CE4E5B9UL);
+  constexpr size_t kShift = kRandomValueBits / 2;
+
+  // a shift of half the width is undone by applying it again
+  auto cnt = (val * kInv2) & kRandomValueMask;
+  cnt ^= cnt >> kShift;
+  return (cnt * kInv1) & kRandomValueMask;
+}
+
+/**
+ * @param reserved_bits The bits of target words reserved by a competitor.
+ * @return The most significant bits that the competitor leaves free.
+ */
+constexpr auto
+GetReservedPattern(                //
+    const uint64_t reserved_bits)  //
+    -> uint64_t
+{
+  uint64_t pattern = 0;
+  size_t cnt = 0;
+  for (size_t i = 64; i > 0 && cnt < kReservedPatternBits; --i) {
+    const auto bit = 1UL << (i - 1);
+    if (reserved_bits & bit) continue;
+    pattern |= bit;
+    ++cnt;
+  }
+  return pattern;
+}
+
+#endif  // PMWCAS_BENCHMARK_VALUE_CODEC_HPP
@@ -0,0 +1,271 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "micro_target.hpp"
+
+// C++ standard libraries
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+// system headers
+#include <sys/stat.h>
+
+// external system libraries
+#include <libpmem.h>
+#include <libpmemobj.h>
+
+// external libraries
+#include "pmem/atomic/atomic.hpp"
+#include "pmwcas.h"
+
+// local sources
+#include "common.hpp"
+#include "competitor.hpp"
+
+namespace
+{
+/*##############################################################################
+ * Local constants
+ *############################################################################*/
+
+/// @brief A directory name for microbenchmarks.
+constexpr char kMicroBenchPath[] = "pmwcas_micro_bench";
+
+/// @brief A layout name for the pool of PMwCAS descriptors.
+constexpr char kPMwCASName[] = "pmwcas";
+
+/// @brief A layout name for the pool of microsoft/pmwcas descriptors.
+constexpr char kMicrosoftPMwCASName[] = "microsoft_pmwcas";
+
+/// @brief A layout name for target words.
+constexpr char kWordsName[] = "words";
+
+/// @brief The size of a pool for microsoft/pmwcas descriptors (8GB).
+constexpr size_t kMicrosoftPoolSize = PMEMOBJ_MIN_POOL * 1024;
+
+/// @brief The number of partitions for microsoft/pmwcas descriptors.
+constexpr uint32_t kMicrosoftPartition = DBGROUP_MAX_THREAD_NUM;
+
+/// @brief The number of microsoft/pmwcas descriptors in each partition.
+constexpr uint32_t kMicrosoftDescPerPartition = 1024;
+
+/// @brief The number of words in each cache line.
+constexpr size_t kWordsPerLine = kCacheLineSize / kWordSize;
+
+/// @brief File permission for pmemobj_pool.
+constexpr auto kModeRW = S_IRUSR | S_IWUSR;  // NOLINT
+
+/// @brief An alias of std::memory_order_relaxed.
+constexpr std::memory_order kMORelax = std::memory_order_relaxed;
+
+}  // namespace
+
+/*##############################################################################
+ * Public constructors and destructors
+ *############################################################################*/
+
+MicroTarget::MicroTarget(  //
+    const std::string &pmem_dir_str,
+    const Primitive primitive,
+    const Sharing sharing,
+    const size_t target_num,
+    const bool dirty_lines,
+    const size_t thread_num)
+    : primitive_{primitive},
+      sharing_{sharing},
+      target_num_{target_num},
+      dirty_lines_{dirty_lines},
+      thread_num_{thread_num}
+{
+  // reset a target directory
+  pmem_dir_str_ = GetPath(pmem_dir_str, kMicroBenchPath);
+  std::filesystem::remove_all(pmem_dir_str_);
+  std::filesystem::create_directories(pmem_dir_str_);
+
+  // prepare cache lines enough for any placement of target words
+  const size_t words_size = (thread_num * kMaxTargetNum + 1) * kCacheLineSize;
+  const auto &path = GetPath(pmem_dir_str_, kWordsName);
+  pop_ = pmemobj_create(path.c_str(), kWordsName, words_size + PMEMOBJ_MIN_POOL, kModeRW);
+  if (pop_ == nullptr) throw std::runtime_error{pmemobj_errormsg()};
+
+  auto &&root = pmemobj_root(pop_, words_size);
+  if (root.off == 0) throw std::runtime_error{pmemobj_errormsg()};
+  root.off = (root.off + kCacheLineSize - 1) & ~(kCacheLineSize - 1);
+  words_ = reinterpret_cast<uint64_t *>(pmemobj_direct(root));
+
+  // prepare a descriptor pool only if needed
+  if (primitive_ == kPMwCASDesc) {
+    const auto &pmwcas_path = GetPath(pmem_dir_str_, kPMwCASName);
+    pmwcas_pool_ = std::make_unique<PMwCAS>(pmwcas_path, kPMwCASName);
+  } else if (primitive_ == kMicrosoftDesc || primitive_ == kEpoch) {
+    const auto &pmwcas_path = GetPath(pmem_dir_str_, kMicrosoftPMwCASName);
+    ::pmwcas::InitLibrary(
+        pmwcas::PMDKAllocator::Create(pmwcas_path.c_str(), kMicrosoftPMwCASName,
+                                      kMicrosoftPoolSize),
+        pmwcas::PMDKAllocator::Destroy,    //
+        pmwcas::LinuxEnvironment::Create,  //
+        pmwcas::LinuxEnvironment::Destroy);
+    microsoft_pool_ = std::make_unique<MicrosoftPMwCAS>(
+        kMicrosoftPartition * kMicrosoftDescPerPartition, kMicrosoftPartition);
+  }
+}
+
+MicroTarget::~MicroTarget()
+{
+  pmwcas_pool_ = nullptr;
+  microsoft_pool_ = nullptr;
+  pmemobj_close(pop_);
+  std::filesystem::remove_all(pmem_dir_str_);
+}
+
+/*##############################################################################
+ * Setup/Teardown for workers
+ *############################################################################*/
+
+void
+MicroTarget::SetUpForWorker()
+{
+  std::lock_guard guard{worker_mtx_};
+  const auto id = workers_.size();
+  assert(id < thread_num_);
+
+  auto &worker = workers_.emplace_back(std::make_unique<Worker>());
+  for (size_t i = 0; i < kMaxTargetNum; ++i) {
+    worker->addrs[i] = GetAddr(id, i);
+    worker->vals[i] = ::dbgroup::pmem::atomic::PLoad(worker->addrs[i], kMORelax);
+  }
+  tls_worker_ = worker.get();
+}
+
+/*##############################################################################
+ * Public APIs
+ *############################################################################*/
+
+auto
+MicroTarget::Execute(                              //
+    [[maybe_unused]] const MicroOperation &ops)  //
+    -> size_t
+{
+  using PMwCASField = ::pmwcas::MwcTargetField<uint64_t>;
+
+  auto &w = *tls_worker_;
+  const auto n = target_num_;
+  if (dirty_lines_) {
+    MakeLinesDirty(w, (primitive_ == kPMwCASDesc || primitive_ == kMicrosoftDesc) ? n : 1);
+  }
+
+  switch (primitive_) {
+    case kPLoad:
+      w.vals[0] = ::dbgroup::pmem::atomic::PLoad(w.addrs[0], kMORelax);
+      break;
+
+    case kPCAS:
+      // the expected value is updated when PCAS fails
+      if (::dbgroup::pmem::atomic::PCAS(w.addrs[0], w.vals[0], w.vals[0] + 1, kMORelax,
+                                        kMORelax)) {
+        ++w.vals[0];
+      }
+      break;
+
+    case kPMwCASDesc: {
+      auto *desc = pmwcas_pool_->Get();
+      for (size_t i = 0; i < n; ++i) {
+        desc->Add(w.addrs[i], w.vals[i], w.vals[i] + 1, kMORelax);
+      }
+      const auto success = desc->PMwCAS();
+      for (size_t i = 0; i < n; ++i) {
+        w.vals[i] = (success) ? w.vals[i] + 1
+                              : ::dbgroup::pmem::atomic::PLoad(w.addrs[i], kMORelax);
+      }
+      break;
+    }
+
+    case kMicrosoftDesc: {
+      auto *epoch = microsoft_pool_->GetEpoch();
+      epoch->Protect();
+      auto *desc = microsoft_pool_->AllocateDescriptor();
+      for (size_t i = 0; i < n; ++i) {
+        desc->AddEntry(w.addrs[i], w.vals[i], w.vals[i] + 1);
+      }
+      const auto success = desc->MwCAS();
+      for (size_t i = 0; i < n; ++i) {
+        w.vals[i] = (success) ? w.vals[i] + 1
+                              : reinterpret_cast<PMwCASField *>(w.addrs[i])->GetValueProtected();
+      }
+      epoch->Unprotect();
+      break;
+    }
+
+    case kEpoch: {
+      auto *epoch = microsoft_pool_->GetEpoch();
+      epoch->Protect();
+      epoch->Unprotect();
+      break;
+    }
+
+    case kFlushFence:
+    default:
+      pmem_flush(w.addrs[0], kWordSize);
+      pmem_drain();
+      break;
+  }
+
+  return 1;
+}
+
+/*##############################################################################
+ * Internal utilities
+ *############################################################################*/
+
+auto
+MicroTarget::GetAddr(  //
+    const size_t worker_id,
+    const size_t i) const  //
+    -> uint64_t *
+{
+  switch (sharing_) {
+    case kFalseSharing: {
+      // pack the i-th words of up to eight workers into each line
+      const auto line_num = (thread_num_ + kWordsPerLine - 1) / kWordsPerLine;
+      const auto line = i * line_num + worker_id / kWordsPerLine;
+      return words_ + line * kWordsPerLine + worker_id % kWordsPerLine;
+    }
+    case kTrueSharing:
+      return words_ + i * kWordsPerLine;
+    case kNoSharing:
+    default:
+      return words_ + (worker_id * kMaxTargetNum + i) * kWordsPerLine;
+  }
+}
+
+void
+MicroTarget::MakeLinesDirty(  //
+    const Worker &worker,
+    const size_t n) const
+{
+  // use atomic RMW so that concurrent updates by other workers are not lost
+  for (size_t i = 0; i < n; ++i) {
+    reinterpret_cast<std::atomic_uint64_t *>(worker.addrs[i])->fetch_add(0, kMORelax);
+  }
+}
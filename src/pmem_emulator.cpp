@@ -0,0 +1,97 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// corresponding header
+#include "pmem_emulator.hpp"
+
+// C++ standard libraries
+#include <cstddef>
+
+// system headers
+#include <dlfcn.h>
+
+/*##############################################################################
+ * Interposed libpmem functions
+ *
+ * The executable's definitions take precedence over the shared libpmem, so
+ * every competitor that persists data via libpmem pays emulated delays and
+ * uses the selected persistence mode. Preemptions armed by workers also fire
+ * here. The original functions are called only in the native mode.
+ *############################################################################*/
+
+namespace
+{
+/**
+ * @tparam Func The type of a function.
+ * @param name The name of a libpmem function.
+ * @return The original function in libpmem.
+ */
+template <class Func>
+auto
+GetOriginal(  //
+    const char *name)  //
+    -> Func *
+{
+  return reinterpret_cast<Func *>(dlsym(RTLD_NEXT, name));
+}
+
+}  // namespace
+
+extern "C" {
+
+void
+pmem_flush(  //
+    const void *addr,
+    size_t len)
+{
+  static auto *const original = GetOriginal<void(const void *, size_t)>("pmem_flush");
+  PreemptIfPublished();
+  EmulateFlush(addr, len);
+  if (!FlushBySelectedMode(addr, len)) {
+    original(addr, len);
+  }
+}
+
+void
+pmem_drain()
+{
+  static auto *const original = GetOriginal<void()>("pmem_drain");
+  PreemptIfPublished();
+  EmulateFence();
+  if (GetPMEMDelay().mode == kNativePersist) {
+    original();
+  } else {
+    _mm_sfence();
+  }
+}
+
+void
+pmem_persist(  //
+    const void *addr,
+    size_t len)
+{
+  static auto *const original = GetOriginal<void(const void *, size_t)>("pmem_persist");
+  PreemptIfPublished();
+  EmulateFlush(addr, len);
+  EmulateFence();
+  if (FlushBySelectedMode(addr, len)) {
+    _mm_sfence();
+  } else {
+    original(addr, len);
+  }
+}
+
+}  // extern "C"
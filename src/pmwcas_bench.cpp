@@ -15,23 +15,69 @@
  */
 
 // C++ standard libraries
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdlib>
 #include <filesystem>
 #include <iostream>
+#include <mutex>
 #include <random>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// system headers
+#include <sys/utsname.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 // external system libraries
 #include <gflags/gflags.h>
+#include <libpmemobj.h>
 
 // external libraries
 #include "benchmark/benchmarker.hpp"
 
 // local sources
+#include "common.hpp"
 #include "competitor.hpp"
+#include "contention_manager.hpp"
 #include "operation_engine.hpp"
+#include "pmem_emulator.hpp"
 #include "pmwcas_target.hpp"
+#include "process_barrier.hpp"
+#include "sample_stats.hpp"
+#include "tsc_clock.hpp"
 #include "validaters.hpp"
+#include "value_codec.hpp"
+
+/*##############################################################################
+ * Build information
+ *############################################################################*/
+
+#ifndef PMWCAS_BENCH_GIT_COMMIT
+#define PMWCAS_BENCH_GIT_COMMIT "unknown"
+#endif
+
+#ifndef PMWCAS_BENCH_PMEM_ATOMIC_COMMIT
+#define PMWCAS_BENCH_PMEM_ATOMIC_COMMIT "unknown"
+#endif
+
+#ifndef PMWCAS_BENCH_MICROSOFT_PMWCAS_COMMIT
+#define PMWCAS_BENCH_MICROSOFT_PMWCAS_COMMIT "unknown"
+#endif
+
+#ifndef PMWCAS_BENCH_CPP_BENCH_COMMIT
+#define PMWCAS_BENCH_CPP_BENCH_COMMIT "unknown"
+#endif
+
+#ifndef PMWCAS_BENCH_BUILD_TYPE
+#define PMWCAS_BENCH_BUILD_TYPE ""
+#endif
 
 /*##############################################################################
  * Options for selecting competitors
@@ -39,10 +85,16 @@
 
 DEFINE_bool(pmwcas, false, "Use our PMwCAS as a competitor.");
 
+DEFINE_bool(pmwcas_dirty, false, "Use our PMwCAS with dirty flags as a competitor.");
+
 DEFINE_bool(microsoft_pmwcas, false, "Use a microsoft/pmwcas as a competitor.");
 
 DEFINE_bool(pcas, false, "Use PCAS as a competitor.");
 
+DEFINE_bool(lock, false, "Use a blocking baseline with striped spinlocks as a competitor.");
+
+DEFINE_bool(null, false, "Use a dummy competitor to measure the overhead of this harness.");
+
 /*##############################################################################
  * Options for controling workload
  *############################################################################*/
@@ -53,6 +105,12 @@ DEFINE_validator(num_exec, &ValidateNonZero);
 DEFINE_uint64(num_thread, 8, "The number of worker threads for benchmarking.");
 DEFINE_validator(num_thread, &ValidateNonZero);
 
+DEFINE_uint64(num_process, 1,
+              "The number of forked processes sharing an array and descriptor pools (each "
+              "runs --num_thread workers after opening and mapping pool files by itself). "
+              "microsoft/pmwcas is not supported.");
+DEFINE_validator(num_process, &ValidateNonZero);
+
 DEFINE_double(skew_parameter, 0, "A skew parameter (based on Zipf's law).");
 DEFINE_validator(skew_parameter, &ValidatePositiveVal);
 
@@ -62,6 +120,112 @@ DEFINE_validator(arr_cap, &ValidateNonZero);
 DEFINE_uint64(block_size, 256, "The size of each memory block.");
 DEFINE_validator(block_size, &ValidateBlockSize);
 
+DEFINE_uint64(words_per_group, 1,
+              "The number of words co-located in each memory block. Each operation selects "
+              "its targets from the same block, so a value other than one must not be less "
+              "than the number of target words.");
+DEFINE_validator(words_per_group, &ValidatePowerOfTwo);
+
+DEFINE_uint64(segment_size, 0,
+              "The size of array blocks in each pool file in MiB (0: use a single pool file). "
+              "Each file also holds one extra block and PMEMOBJ_MIN_POOL bytes of metadata. "
+              "Large arrays can be split into multiple files with this option.");
+DEFINE_validator(segment_size, &ValidateZeroOrPowerOfTwo);
+
+DEFINE_string(workload, "increment",
+              "A workload type: \"increment\" adds one to all the targets and \"transfer\" "
+              "moves money from a payer to 1--(k-1) payees.");
+DEFINE_validator(workload, &ValidateWorkload);
+
+DEFINE_string(value_mode, "counter",
+              "An encoding of values written by operations: counter (increments), pointer "
+              "(addresses of fresh nodes in a second pool), random (scrambled 62-bit values), "
+              "or reserved (with the highest bits that each competitor leaves free).");
+DEFINE_validator(value_mode, &ValidateValueMode);
+
+DEFINE_double(pcas_ratio, 0,
+              "The ratio of single-word PCAS operations mixed into PMwCAS ones on the same "
+              "array (increment workloads only).");
+DEFINE_validator(pcas_ratio, &ValidateRatio);
+
+DEFINE_uint64(conflict_region, 0,
+              "The number of words in a region shared by all the workers, while the rest of "
+              "an array is split into private partitions (0: disable conflict control).");
+
+DEFINE_double(conflict_ratio, 0,
+              "The ratio of operations whose targets are in the shared conflict region.");
+DEFINE_validator(conflict_ratio, &ValidateRatio);
+
+DEFINE_string(contention_manager, "none",
+              "A policy for failed attempts: none (retry immediately), exponential (backoff), "
+              "randomized (backoff), or adaptive (backoff only under high failure rates).");
+DEFINE_validator(contention_manager, &ValidateContentionManager);
+
+DEFINE_uint64(prefetch_interleave, 1,
+              "The number of independent operations whose prefetches are interleaved in each "
+              "worker (1: complete each operation before the next one). Only the loads of "
+              "target words overlap; each attempt runs a whole PMwCAS including persistence. "
+              "This disables latency per operation (--throughput=false), --tsc_latency, and "
+              "--contention_breakdown, and latency by operation type sums only attempts.");
+DEFINE_validator(prefetch_interleave, &ValidateNonZero);
+
+DEFINE_uint64(preempt_interval, 0,
+              "Preempt each worker once per the given number of attempts while its swap is "
+              "published, i.e., at the first persistence after a target word is modified "
+              "(0: disable preemption). This requires -DPMWCAS_BENCH_EMULATE_PMEM=ON.");
+
+DEFINE_uint64(preempt_sleep_us, 0,
+              "The length of each injected preemption in microseconds (0: sched_yield).");
+
+DEFINE_uint64(prefetch_distance, 0,
+              "The number of operations to look ahead for prefetching target words (0: "
+              "disable prefetching). Each target keeps copies of the queues of workers to "
+              "look ahead.");
+DEFINE_validator(prefetch_distance, &ValidatePrefetchDistance);
+
+/*##############################################################################
+ * Options for descriptor pools
+ *############################################################################*/
+
+DEFINE_uint64(desc_pool_size, 0,
+              "The size of a pool for microsoft/pmwcas descriptors in MiB (0: 8192 MiB). A "
+              "non-zero value must satisfy the minimum pool size of libpmemobj.");
+DEFINE_validator(desc_pool_size, &ValidateDescPoolSize);
+
+DEFINE_uint64(desc_capacity, 0,
+              "The number of microsoft/pmwcas descriptors (0: 1024 for each partition).");
+DEFINE_validator(desc_capacity, &ValidateUInt32);
+
+DEFINE_uint64(desc_partition, 0,
+              "The number of partitions for microsoft/pmwcas descriptors (0: the maximum "
+              "number of threads).");
+DEFINE_validator(desc_partition, &ValidateUInt32);
+
+DEFINE_uint64(epoch_scope, 1,
+              "The number of operations that each worker executes in one protected epoch of "
+              "microsoft/pmwcas (0: a whole worker run).");
+
+DEFINE_bool(epoch_lag, false,
+            "Output the lag between the current and reclaimable epochs of microsoft/pmwcas "
+            "sampled after each operation.");
+
+/*##############################################################################
+ * Options for emulating persistent memory
+ *############################################################################*/
+
+DEFINE_string(persist_mode, "native",
+              "An instruction for persisting cache lines: native (each competitor's choice), "
+              "clflush, clflushopt, clwb, or eadr (elide flushes but keep fences).");
+DEFINE_validator(persist_mode, &ValidatePersistMode);
+
+#ifdef PMWCAS_BENCH_EMULATE_PMEM
+DEFINE_uint64(flush_delay_ns, 0, "An emulated delay for flushing each cache line in ns.");
+
+DEFINE_uint64(fence_delay_ns, 0, "An emulated delay for each store fence in ns.");
+
+DEFINE_uint64(read_delay_ns, 0, "An emulated delay for reading each target word in ns.");
+#endif
+
 /*##############################################################################
  * Utility options
  *############################################################################*/
@@ -76,36 +240,780 @@ DEFINE_bool(csv, false, "Output benchmark results as a CSV format.");
 
 DEFINE_bool(throughput, true, "true: measure throughput, false: measure latency.");
 
+DEFINE_bool(verify, true, "Verify the contents of an array after each run.");
+
+DEFINE_bool(footprint, false, "Output the PMEM/DRAM footprint after each run.");
+
+DEFINE_bool(metadata, false,
+            "Output the commits of competitors, build settings, the machine, and non-default "
+            "options as '# key: value' lines and exit.");
+
+DEFINE_bool(contention_breakdown, false,
+            "Output latency percentiles bucketed by the Zipf rank of the hottest target and "
+            "the number of retries of each operation.");
+
+DEFINE_uint64(warmup, 0, "The number of unmeasured runs before measured repetitions.");
+
+DEFINE_uint64(repeat, 1,
+              "The maximum number of measured repetitions in this process (two or more outputs "
+              "the mean, stddev, median, and 95% confidence interval of each metric).");
+DEFINE_validator(repeat, &ValidateNonZero);
+
+DEFINE_double(ci_threshold, 0,
+              "Stop repetitions when the 95% confidence intervals of throughput and thread time "
+              "per operation are within this ratio of their means (0: always run --repeat "
+              "times).");
+DEFINE_validator(ci_threshold, &ValidatePositiveVal);
+
+DEFINE_uint64(gen_thread, 0,
+              "The number of threads for generating operations before measurement (0: the "
+              "number of hardware threads).");
+
+DEFINE_bool(gen_time, false, "Output the time for generating operations as a CSV line.");
+
+DEFINE_bool(tsc_latency, false,
+            "Measure latency with invariant TSC reads and per-thread histograms at constant "
+            "memory instead of per-operation records (throughput is also reported).");
+
 /*##############################################################################
  * Utility functions
  *############################################################################*/
 
+/**
+ * @return A policy for failed attempts specified by a command line option.
+ */
+auto
+GetContentionPolicy()  //
+    -> ContentionPolicy
+{
+  if (FLAGS_contention_manager == "exponential") return kExponentialBackoff;
+  if (FLAGS_contention_manager == "randomized") return kRandomizedBackoff;
+  if (FLAGS_contention_manager == "adaptive") return kAdaptiveBackoff;
+  return kNoBackoff;
+}
+
+/**
+ * @return An encoding of values specified by a command line option.
+ */
+auto
+GetValueMode()  //
+    -> ValueMode
+{
+  if (FLAGS_value_mode == "pointer") return kPointerValue;
+  if (FLAGS_value_mode == "random") return kRandomValue;
+  if (FLAGS_value_mode == "reserved") return kReservedValue;
+  return kCounterValue;
+}
+
+/**
+ * @brief Output the configuration of this build and machine as comment lines.
+ *
+ * Comparison tools parse these lines to detect which settings differ between
+ * two sets of results.
+ */
+void
+ReportMetadata()
+{
+  utsname uts{};
+  const auto &kernel = (uname(&uts) == 0) ? std::string{uts.release} : std::string{};
+  const auto *build_type = PMWCAS_BENCH_BUILD_TYPE;
+
+  std::cout << "# pmwcas_bench: " << PMWCAS_BENCH_GIT_COMMIT << "\n"
+            << "# pmem_atomic: " << PMWCAS_BENCH_PMEM_ATOMIC_COMMIT << "\n"
+            << "# microsoft_pmwcas: " << PMWCAS_BENCH_MICROSOFT_PMWCAS_COMMIT << "\n"
+            << "# cpp_bench: " << PMWCAS_BENCH_CPP_BENCH_COMMIT << "\n"
+            << "# compiler: " << __VERSION__ << "\n"
+            << "# build_type: " << build_type << "\n"
+            << "# max_target_num: " << kMaxTargetNum << "\n"
+#ifdef PMWCAS_BENCH_EMULATE_PMEM
+            << "# emulate_pmem: on\n"
+#else
+            << "# emulate_pmem: off\n"
+#endif
+            << "# cpu: " << GetCPUModel() << "\n"
+            << "# cpu_num: " << std::thread::hardware_concurrency() << "\n"
+            << "# kernel: " << kernel << "\n";
+
+  std::vector<gflags::CommandLineFlagInfo> flags{};
+  gflags::GetAllFlags(&flags);
+  for (const auto &flag : flags) {
+    if (flag.is_default || flag.name == "metadata") continue;
+    std::cout << "# flag: --" << flag.name << "=" << flag.current_value << "\n";
+  }
+}
+
+/**
+ * @brief Output the PMEM/DRAM footprint of a benchmark target.
+ *
+ * @tparam Target_t The class of a benchmark target.
+ * @param target A benchmark target.
+ */
+template <class Target_t>
+void
+ReportFootprint(  //
+    const Target_t &target)
+{
+  const auto array_size = target.GetArrayFileSize();
+  const auto desc_size = target.GetDescPoolFileSize();
+  const auto desc_cap = target.GetDescCapacity();
+  const auto rss = GetProcStatusSize("VmRSS");
+  const auto peak_rss = GetProcStatusSize("VmHWM");
+
+  if (FLAGS_csv) {
+    std::cout << "footprint," << array_size << "," << desc_size << "," << desc_cap << "," << rss
+              << "," << peak_rss << "\n";
+  } else {
+    std::cout << "Footprint:\n"
+              << "  PMEM for an array:       " << array_size << " bytes\n"
+              << "  PMEM for descriptors:    " << desc_size << " bytes\n"
+              << "  Descriptors in a pool:   " << desc_cap << "\n"
+              << "  DRAM (current RSS):      " << rss << " bytes\n"
+              << "  DRAM (peak RSS):         " << peak_rss << " bytes\n";
+  }
+}
+
+/**
+ * @brief Output the count, derived throughput, and latency of each operation type.
+ *
+ * Throughput is not measured but derived from the time that workers spend in
+ * each type, so it excludes the overhead of the benchmark driver. Latency
+ * includes the overhead of one clock read around each operation.
+ *
+ * @param stats The statistics of each operation type.
+ * @param thread_num The number of worker threads.
+ */
+void
+ReportOpTypeStats(  //
+    const OpTypeStats &stats,
+    const size_t thread_num)
+{
+  constexpr double kPercentiles[] = {0.5, 0.9, 0.99};
+
+  const auto sec_per_thread = (stats.pcas_ns + stats.pmwcas_ns) / 1E9 / thread_num;
+  const auto print_type = [&](const char *label, const size_t num, const size_t ns,
+                              const LatencyHistogram &hist) {
+    const auto tput = (sec_per_thread > 0) ? num / sec_per_thread : 0;
+    const auto avg = (num > 0) ? ns / num : 0;
+    if (FLAGS_csv) {
+      std::cout << "," << num << "," << tput << "," << avg;
+      for (const auto p : kPercentiles) {
+        std::cout << "," << hist.GetPercentile(p);
+      }
+    } else {
+      std::cout << "  " << label << num << " ops, " << tput << " ops/s (derived), avg/p50/p90/p99 "
+                << avg;
+      for (const auto p : kPercentiles) {
+        std::cout << "/" << hist.GetPercentile(p);
+      }
+      std::cout << " ns\n";
+    }
+  };
+
+  std::cout << ((FLAGS_csv) ? "op_type" : "Per-type statistics:\n");
+  print_type("PCAS:   ", stats.pcas_num, stats.pcas_ns, stats.pcas_hist);
+  print_type("PMwCAS: ", stats.pmwcas_num, stats.pmwcas_ns, stats.pmwcas_hist);
+  if (FLAGS_csv) {
+    std::cout << "\n";
+  }
+}
+
+/**
+ * @brief Output latency percentiles for each class of Zipf ranks and retries.
+ *
+ * @tparam Target_t The class of a benchmark target.
+ * @param target A benchmark target.
+ */
+template <class Target_t>
+void
+ReportContentionBreakdown(  //
+    const Target_t &target)
+{
+  constexpr double kPercentiles[] = {0.5, 0.9, 0.99, 0.999};
+
+  if (!FLAGS_csv) {
+    std::cout << "Latency by contention [ns]:\n"
+              << "  rank>=  retry>=  count  p50  p90  p99  p99.9\n";
+  }
+  const auto &hists = target.GetContentionHistograms();
+  for (size_t r = 0; r < Target_t::kRankClassNum; ++r) {
+    for (size_t c = 0; c < Target_t::kRetryClassNum; ++c) {
+      const auto &hist = hists[r * Target_t::kRetryClassNum + c];
+      if (hist.GetCount() == 0) continue;
+
+      const auto rank_min = (1UL << r) - 1;
+      const auto retry_min = (c == 0) ? 0 : 1UL << (c - 1);
+      const auto *sep = (FLAGS_csv) ? "," : "  ";
+      std::cout << ((FLAGS_csv) ? "contention," : "  ") << rank_min << sep << retry_min << sep
+                << hist.GetCount();
+      for (const auto p : kPercentiles) {
+        std::cout << sep << hist.GetPercentile(p);
+      }
+      std::cout << "\n";
+    }
+  }
+}
+
+/**
+ * @brief Output the configured and measured rates of conflicts.
+ *
+ * @tparam Target_t The class of a benchmark target.
+ * @param target A benchmark target.
+ */
+template <class Target_t>
+void
+ReportConflictRate(  //
+    const Target_t &target)
+{
+  // the blocking baseline never fails, so it counts operations that waited for locks
+  constexpr auto kIsLock = std::is_same_v<Target_t, PMwCASTarget<LockMwCAS>>;
+
+  const auto exec_num = target.GetExecNum();
+  const auto rate =
+      (exec_num > 0) ? static_cast<double>(target.GetConflictNum()) / exec_num : 0;
+
+  if (FLAGS_csv) {
+    std::cout << "conflict," << FLAGS_conflict_ratio << "," << rate << "\n";
+  } else {
+    std::cout << "Conflicts:\n"
+              << "  Operations in the shared region: " << FLAGS_conflict_ratio << "\n"
+              << "  Operations that failed once+:    " << rate
+              << ((kIsLock) ? " (waited for locks)" : "") << "\n";
+  }
+}
+
+/**
+ * @brief Output the lag of descriptor reclamation in epochs.
+ *
+ * @tparam Target_t The class of a benchmark target.
+ * @param target A benchmark target.
+ */
+template <class Target_t>
+void
+ReportEpochLag(  //
+    const Target_t &target)
+{
+  const auto &lag = target.GetEpochLag();
+  const auto avg = (lag.sample_num > 0) ? static_cast<double>(lag.sum) / lag.sample_num : 0;
+
+  if (FLAGS_csv) {
+    std::cout << "epoch," << FLAGS_epoch_scope << "," << avg << "," << lag.max << "\n";
+  } else {
+    std::cout << "Epoch scope: " << FLAGS_epoch_scope << " ops (0: a worker run)\n"
+              << "  Average reclamation lag [epochs]: " << avg << "\n"
+              << "  Maximum reclamation lag [epochs]: " << lag.max << "\n";
+  }
+}
+
+/**
+ * @brief Output latency percentiles recorded in TSC cycles.
+ *
+ * @tparam Target_t The class of a benchmark target.
+ * @param target A benchmark target.
+ * @param clock A calibrated clock for converting cycles into nanoseconds.
+ */
+template <class Target_t>
+void
+ReportTSCLatency(  //
+    const Target_t &target,
+    const TSCClock &clock)
+{
+  constexpr double kPercentiles[] = {0.5, 0.9, 0.99, 0.999, 0.9999, 0.99999, 1.0};
+  constexpr const char *kLabels[] = {"p50", "p90", "p99", "p99.9", "p99.99", "p99.999", "max"};
+  constexpr size_t kNum = sizeof(kPercentiles) / sizeof(kPercentiles[0]);
+
+  const auto &hist = target.GetTSCLatencyHistogram();
+  if (FLAGS_csv) {
+    std::cout << "tsc," << hist.GetCount();
+    for (size_t i = 0; i < kNum; ++i) {
+      std::cout << "," << clock.ToNanos(hist.GetPercentile(kPercentiles[i]));
+    }
+    std::cout << "\n";
+  } else {
+    std::cout << "Latency (TSC, " << clock.GetCyclesPerNano() << " cycles/ns) [ns]:\n"
+              << "  count: " << hist.GetCount() << "\n";
+    for (size_t i = 0; i < kNum; ++i) {
+      std::cout << "  " << kLabels[i] << ": " << clock.ToNanos(hist.GetPercentile(kPercentiles[i]))
+                << "\n";
+    }
+  }
+}
+
+/**
+ * @brief The results of each worker process padded to avoid false sharing.
+ *
+ */
+struct alignas(kCacheLineSize) ProcessResult {
+  /// @brief The statistics of each operation type.
+  OpTypeStats types{};
+
+  /// @brief The total time that workers spend in operations in nanoseconds.
+  size_t busy_ns{0};
+
+  /// @brief The longest execution time of workers in nanoseconds.
+  size_t elapsed_ns{0};
+
+  /// @brief The time for opening and mapping pool files in nanoseconds.
+  size_t map_ns{0};
+};
+
+/**
+ * @brief Generate the operations of all the workers in parallel and output its time.
+ *
+ * The generated operations do not depend on the number of threads, so this
+ * only shortens the time before measurement. With `--prefetch_distance`, a
+ * target receives copies of the queues for looking ahead in them.
+ *
+ * @tparam Target_t The class of a benchmark target.
+ * @param target A benchmark target.
+ * @param ops_engine An engine for generating operations.
+ * @param worker_num The number of workers over all the processes.
+ * @param random_seed A seed value for the first worker.
+ */
+template <class Target_t>
+void
+PrepareOperations(  //
+    Target_t &target,
+    OperationEngine &ops_engine,
+    const size_t worker_num,
+    const size_t random_seed)
+{
+  using Clock_t = std::chrono::steady_clock;
+
+  const auto thread_num = (FLAGS_gen_thread > 0)
+                              ? FLAGS_gen_thread
+                              : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  const auto &begin = Clock_t::now();
+  ops_engine.Prepare(worker_num, FLAGS_num_exec, random_seed, thread_num);
+  const auto &end = Clock_t::now();
+  const auto ms = std::chrono::duration<double, std::milli>(end - begin).count();
+
+  if (!FLAGS_csv) {
+    std::cout << "Generation: " << ms << " ms with " << thread_num << " threads\n";
+  } else if (FLAGS_gen_time) {
+    std::cout << "generation," << thread_num << "," << ms << "\n";
+  }
+  if (FLAGS_prefetch_distance > 0) {
+    target.SetPrefetchQueues(ops_engine.GetPreparedQueues(), FLAGS_prefetch_distance);
+  }
+}
+
+/**
+ * @brief Generate the operations of worker threads in advance.
+ *
+ * @param ops_engine An engine for generating operations.
+ * @param random_seed A seed value for the first worker.
+ * @return The queues of operations for each worker.
+ */
+auto
+GenerateOperations(  //
+    OperationEngine &ops_engine,
+    const size_t random_seed)  //
+    -> std::vector<std::vector<Operation>>
+{
+  const auto thread_num = FLAGS_num_thread;
+  std::vector<std::vector<Operation>> operations{};
+  operations.reserve(thread_num);
+  for (size_t i = 0; i < thread_num; ++i) {
+    operations.emplace_back(ops_engine.Generate(FLAGS_num_exec, random_seed + i));
+  }
+  return operations;
+}
+
+/**
+ * @brief Execute given operations with worker threads.
+ *
+ * If workers do not finish within a timeout (e.g., by livelocks), this
+ * process exits with status 124 as the `timeout` command does, because
+ * the workers cannot be stopped in the middle of operations.
+ *
+ * @tparam Target_t The class of a benchmark target.
+ * @param target A benchmark target.
+ * @param operations The queues of operations for each worker.
+ * @param barrier A start barrier for all the workers.
+ * @param result A slot for the elapsed time of workers.
+ * @param timeout_sec A timeout in seconds (zero means no timeout).
+ */
+template <class Target_t>
+void
+RunWorkers(  //
+    Target_t &target,
+    const std::vector<std::vector<Operation>> &operations,
+    ProcessBarrier<ProcessResult> &barrier,
+    ProcessResult &result,
+    const size_t timeout_sec = 0)
+{
+  using Clock_t = std::chrono::steady_clock;
+  constexpr int kTimeoutStatus = 124;
+
+  const auto thread_num = operations.size();
+  std::vector<size_t> elapsed(thread_num);
+  std::mutex mtx{};
+  std::condition_variable cond{};
+  size_t finished_num = 0;
+  std::vector<std::thread> threads{};
+  threads.reserve(thread_num);
+  for (size_t i = 0; i < thread_num; ++i) {
+    threads.emplace_back([&, i] {
+      target.SetUpForWorker();
+      barrier.Wait();
+      const auto &begin = Clock_t::now();
+      target.ExecuteAll(operations[i]);
+      target.TearDownForWorker();
+      const auto &end = Clock_t::now();
+      elapsed[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+
+      std::lock_guard guard{mtx};
+      ++finished_num;
+      cond.notify_one();
+    });
+  }
+  if (timeout_sec > 0) {
+    std::unique_lock lock{mtx};
+    const auto finished = cond.wait_for(lock, std::chrono::seconds{timeout_sec},
+                                        [&] { return finished_num == thread_num; });
+    if (!finished) {
+      std::cerr << "[Error] Workers did not finish within " << timeout_sec << " seconds.\n";
+      std::_Exit(kTimeoutStatus);
+    }
+  }
+  for (auto &&t : threads) t.join();
+
+  for (const auto ns : elapsed) {
+    result.busy_ns += ns;
+    result.elapsed_ns = std::max(result.elapsed_ns, ns);
+  }
+}
+
+/**
+ * @brief Execute operations with the worker threads of a child process.
+ *
+ * Each process opens and maps the pool files of a target by itself before
+ * workers start, and the time for it is recorded separately.
+ *
+ * @tparam Target_t The class of a benchmark target.
+ * @param target A benchmark target inherited from a parent process.
+ * @param ops_engine An engine for generating operations.
+ * @param barrier A start barrier shared among processes.
+ * @param process_id The ID of the calling process.
+ * @param random_seed A seed value for reproducibility.
+ */
+template <class Target_t>
+void
+RunWorkerProcess(  //
+    Target_t &target,
+    OperationEngine &ops_engine,
+    ProcessBarrier<ProcessResult> &barrier,
+    const size_t process_id,
+    const size_t random_seed)
+{
+  using Clock_t = std::chrono::steady_clock;
+
+  // take over operations generated before forking
+  const auto &operations =
+      GenerateOperations(ops_engine, random_seed + process_id * FLAGS_num_thread);
+
+  auto &result = barrier.GetResult(process_id);
+  const auto &begin = Clock_t::now();
+  target.AttachProcess(process_id);
+  const auto &end = Clock_t::now();
+  result.map_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+  RunWorkers(target, operations, barrier, result);
+  result.types = target.GetOpTypeStats();
+}
+
+/**
+ * @brief Run workers in multiple processes sharing the array of a target.
+ *
+ * Worker processes are forked from this process, and each of them opens and
+ * maps the pool files of an array and descriptors again at the inherited
+ * addresses, because descriptors hold the addresses of target words.
+ *
+ * @tparam Target_t The class of a benchmark target.
+ * @param target A benchmark target.
+ * @param ops_engine An engine for generating operations.
+ * @param random_seed A seed value for reproducibility.
+ * @return The statistics of each operation type summed over all the processes.
+ */
+template <class Target_t>
+auto
+RunProcesses(  //
+    Target_t &target,
+    OperationEngine &ops_engine,
+    const size_t random_seed)  //
+    -> OpTypeStats
+{
+  const auto process_num = FLAGS_num_process;
+  ProcessBarrier<ProcessResult> barrier{process_num, process_num * FLAGS_num_thread};
+
+  // child processes take over their operations generated by this process
+  PrepareOperations(target, ops_engine, process_num * FLAGS_num_thread, random_seed);
+  target.PrepareProcesses(process_num);
+
+  // child processes inherit the mappings of the array at the same addresses
+  std::vector<pid_t> pids{};
+  for (size_t i = 0; i < process_num; ++i) {
+    const auto pid = fork();
+    if (pid < 0) throw std::runtime_error{"Failed to fork a worker process."};
+    if (pid == 0) {
+      RunWorkerProcess(target, ops_engine, barrier, i, random_seed);
+      std::_Exit(0);  // skip destructors to keep shared pool files
+    }
+    pids.emplace_back(pid);
+  }
+  for (const auto pid : pids) {
+    int status{};
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      throw std::runtime_error{"A worker process has failed."};
+    }
+  }
+
+  // aggregate the results of all the processes
+  OpTypeStats types{};
+  size_t busy_ns = 0;
+  size_t elapsed_ns = 0;
+  size_t map_ns = 0;
+  for (size_t i = 0; i < process_num; ++i) {
+    const auto &result = barrier.GetResult(i);
+    types.Merge(result.types);
+    busy_ns += result.busy_ns;
+    elapsed_ns = std::max(elapsed_ns, result.elapsed_ns);
+    map_ns = std::max(map_ns, result.map_ns);
+  }
+  const auto exec_num = types.pcas_num + types.pmwcas_num;
+  const auto tput = (elapsed_ns > 0) ? exec_num / (elapsed_ns / 1E9) : 0;
+  const auto thread_time = (exec_num > 0) ? busy_ns / exec_num : 0;
+
+  const auto map_ms = map_ns / 1E6;
+
+  if (FLAGS_csv) {
+    std::cout << "process," << tput << "," << thread_time << "," << map_ms << "\n";
+  } else {
+    std::cout << "Processes: " << process_num << "\n"
+              << "  Throughput [Ops/s]:  " << tput << "\n"
+              << "  Thread time [ns/op]: " << thread_time << "\n"
+              << "  Mapping [ms]:        " << map_ms << "\n";
+  }
+
+  return types;
+}
+
+/**
+ * @brief Output the summary of a metric over repetitions.
+ *
+ * @param label The name of a metric.
+ * @param stats The values of each repetition.
+ */
+void
+ReportSampleStats(  //
+    const std::string &label,
+    const SampleStats &stats)
+{
+  if (FLAGS_csv) {
+    std::cout << "," << stats.GetMean() << "," << stats.GetStdDev() << "," << stats.GetMedian()
+              << "," << stats.GetCIHalfWidth();
+  } else {
+    std::cout << "  " << label << ": mean " << stats.GetMean() << ", stddev "
+              << stats.GetStdDev() << ", median " << stats.GetMedian() << ", 95% CI +/- "
+              << stats.GetCIHalfWidth() << "\n";
+  }
+}
+
+/**
+ * @brief Repeat measurement in this process after warm-up runs.
+ *
+ * All the repetitions execute the same operations, which are generated only
+ * once. Measurement stops early when the 95% confidence intervals of both
+ * throughput and thread time per operation become narrower than
+ * `--ci_threshold`. Thread time is the sum of the run time of workers
+ * divided by operations, so it is not the latency of each operation. Each
+ * run is limited by `--timeout`.
+ *
+ * @tparam Target_t The class of a benchmark target.
+ * @param target A benchmark target.
+ * @param ops_engine An engine for generating operations.
+ * @param random_seed A seed value for reproducibility.
+ */
+template <class Target_t>
+void
+RunRepetitions(  //
+    Target_t &target,
+    OperationEngine &ops_engine,
+    const size_t random_seed)
+{
+  // at least three samples are needed to estimate variance reasonably
+  constexpr size_t kMinRepeatForStop = 3;
+
+  PrepareOperations(target, ops_engine, FLAGS_num_thread, random_seed);
+  const auto &operations = GenerateOperations(ops_engine, random_seed);
+  SampleStats tput{};
+  SampleStats thread_time{};
+  for (size_t i = 0; i < FLAGS_warmup + FLAGS_repeat; ++i) {
+    const auto before = target.GetExecNum();
+    ProcessBarrier<ProcessResult> barrier{1, FLAGS_num_thread};
+    auto &result = barrier.GetResult(0);
+    RunWorkers(target, operations, barrier, result, FLAGS_timeout);
+    if (i < FLAGS_warmup) continue;
+
+    const auto exec_num = target.GetExecNum() - before;
+    const auto ops_per_sec = (result.elapsed_ns > 0) ? exec_num / (result.elapsed_ns / 1E9) : 0;
+    const auto ns_per_op = (exec_num > 0) ? static_cast<double>(result.busy_ns) / exec_num : 0;
+    tput.Add(ops_per_sec);
+    thread_time.Add(ns_per_op);
+    if (!FLAGS_csv) {
+      std::cout << "  Repetition " << tput.GetCount() << ": " << ops_per_sec << " ops/s, "
+                << ns_per_op << " ns/op (thread time)\n";
+    }
+
+    if (FLAGS_ci_threshold > 0 && tput.GetCount() >= kMinRepeatForStop
+        && tput.GetRelativeCI() <= FLAGS_ci_threshold
+        && thread_time.GetRelativeCI() <= FLAGS_ci_threshold) {
+      break;
+    }
+  }
+
+  if (FLAGS_csv) {
+    std::cout << "repetition," << tput.GetCount();
+  } else {
+    std::cout << "Repetitions: " << tput.GetCount() << " (after " << FLAGS_warmup
+              << " warm-up runs)\n";
+  }
+  ReportSampleStats("Throughput [Ops/s] ", tput);
+  ReportSampleStats("Thread time [ns/op]", thread_time);
+  if (FLAGS_csv) {
+    std::cout << "\n";
+  }
+}
+
 /**
  * @brief Run procedures for benchmarking with a given implementation.
  *
  * @tparam Implementation an implementation to be benchmarked.
  * @param target_name the output name of a implementation.
  * @param pmem_dir_str the path to persistent memory.
+ * @param target_num the number of target words for PMwCAS.
+ * @param workload a workload type.
  */
 template <class Implementation>
 void
 Run(  //
     const std::string &target_name,
     const std::string &pmem_dir_str,
-    const size_t target_num)
+    const size_t target_num,
+    const Workload workload)
 {
   using Target_t = PMwCASTarget<Implementation>;
   using Bench_t = ::dbgroup::benchmark::Benchmarker<Target_t, Operation, OperationEngine>;
-  constexpr auto kPercentile = "0.01,0.05,0.10,0.20,0.30,0.40,0.50,0.60,0.70,0.80,0.90,0.95,0.99";
+  constexpr auto kPercentile =
+      "0.01,0.05,0.10,0.20,0.30,0.40,0.50,0.60,0.70,0.80,0.90,0.95,0.99,0.999";
 
   const auto random_seed = (FLAGS_seed.empty()) ? std::random_device{}()  //
                                                 : std::stoul(FLAGS_seed);
-  Target_t target{pmem_dir_str, FLAGS_arr_cap, FLAGS_block_size};
-  OperationEngine ops_engine{target_num, FLAGS_arr_cap, FLAGS_skew_parameter, random_seed};
+  constexpr size_t kMiB = 1UL << 20UL;
+  const DescPoolConfig desc_config{FLAGS_desc_pool_size * kMiB, FLAGS_desc_capacity,
+                                   FLAGS_desc_partition};
+  Target_t target{pmem_dir_str,          FLAGS_arr_cap,        FLAGS_block_size,
+                  FLAGS_words_per_group, FLAGS_segment_size * kMiB, desc_config};
+  OperationEngine ops_engine{target_num, FLAGS_arr_cap,         FLAGS_skew_parameter,
+                             workload,   FLAGS_words_per_group, FLAGS_pcas_ratio};
+  if (FLAGS_conflict_region > 0) {
+    ops_engine.SetConflictControl(FLAGS_num_thread, FLAGS_conflict_ratio, FLAGS_conflict_region);
+  }
+  const auto scan_thread_num = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  const auto value_mode = GetValueMode();
+  if (value_mode != kCounterValue) {
+    // each completed operation writes a fresh node for each target in pointer mode
+    const auto worker_num = (FLAGS_warmup + FLAGS_repeat) * FLAGS_num_thread;
+    const auto node_num = Target_t::GetNodeNum(worker_num, FLAGS_num_exec, target_num);
+    try {
+      target.SetValueMode(value_mode, node_num);
+    } catch (const std::runtime_error &e) {
+      // skip only this competitor so that the others can be measured
+      std::cerr << "[Error] " << target_name << ": " << e.what() << "\n";
+      return;
+    }
+  }
+  if (workload == kTransfer) {
+    target.Fill(kInitialBalance, scan_thread_num);
+  }
+  if (FLAGS_pcas_ratio > 0) {
+    target.EnableOpTypeLatency();
+  }
+  if (FLAGS_contention_breakdown) {
+    target.EnableContentionBreakdown();
+  }
+  if (FLAGS_tsc_latency) {
+    target.EnableTSCLatency();
+  }
+  target.SetContentionPolicy(GetContentionPolicy());
+  target.SetFixedTargetNum((workload == kTransfer) ? 0 : target_num);
+  target.SetInterleaveWidth(FLAGS_prefetch_interleave, FLAGS_num_exec);
+  target.SetPreemption(FLAGS_preempt_interval, FLAGS_preempt_sleep_us);
+  target.SetEpochScope(FLAGS_epoch_scope);
+  if (FLAGS_epoch_lag) {
+    target.EnableEpochLag();
+  }
 
-  Bench_t bench{target,      target_name,      ops_engine, FLAGS_num_exec, FLAGS_num_thread,
-                random_seed, FLAGS_throughput, FLAGS_csv,  FLAGS_timeout,  kPercentile};
-  bench.Run();
+  if (FLAGS_csv) {
+    std::cout << "# persist_mode: " << FLAGS_persist_mode << "\n";
+  } else {
+    std::cout << "Persistence mode: " << FLAGS_persist_mode << "\n";
+  }
+
+  OpTypeStats types{};
+  if (FLAGS_num_process > 1) {
+    if (!FLAGS_csv) {
+      std::cout << "Target: " << target_name << "\n";
+    }
+    types = RunProcesses(target, ops_engine, random_seed);
+  } else if (FLAGS_warmup > 0 || FLAGS_repeat > 1) {
+    if (!FLAGS_csv) {
+      std::cout << "Target: " << target_name << "\n";
+    }
+    RunRepetitions(target, ops_engine, random_seed);
+    types = target.GetOpTypeStats();
+  } else {
+    // the benchmarker receives the prepared queue of each worker by its seed
+    PrepareOperations(target, ops_engine, FLAGS_num_thread, random_seed);
+
+    // histograms replace the per-operation records of the benchmarker
+    const auto throughput = FLAGS_throughput || FLAGS_tsc_latency;
+    Bench_t bench{target,      target_name, ops_engine, FLAGS_num_exec, FLAGS_num_thread,
+                  random_seed, throughput,  FLAGS_csv,  FLAGS_timeout,  kPercentile};
+    bench.Run();
+    types = target.GetOpTypeStats();
+  }
+
+  // check the sum of all the words to detect broken atomicity
+  if (FLAGS_verify && !std::is_same_v<Implementation, NullPMwCAS>) {
+    const auto expected = (workload == kTransfer)
+                              ? kInitialBalance * FLAGS_arr_cap
+                              : types.pcas_num + types.pmwcas_num * target_num;
+    const auto actual = target.Sum(scan_thread_num);
+    if (actual != expected) {
+      throw std::runtime_error{"The sum of an array is inconsistent: expected "
+                               + std::to_string(expected) + ", actual " + std::to_string(actual)};
+    }
+  }
+
+  if (FLAGS_pcas_ratio > 0) {
+    ReportOpTypeStats(types, FLAGS_num_process * FLAGS_num_thread);
+  }
+  if (FLAGS_contention_breakdown) {
+    ReportContentionBreakdown(target);
+  }
+  if (FLAGS_tsc_latency) {
+    ReportTSCLatency(target, TSCClock{});
+  }
+  if (FLAGS_conflict_region > 0) {
+    ReportConflictRate(target);
+  }
+  if (FLAGS_epoch_lag && std::is_same_v<Implementation, MicrosoftPMwCAS>) {
+    ReportEpochLag(target);
+  }
+  if (FLAGS_footprint) {
+    ReportFootprint(target);
+  }
 }
 
 /*##############################################################################
@@ -122,6 +1030,10 @@ main(  //
   constexpr bool kRemoveParsedFlags = true;
   gflags::SetUsageMessage("measures throughput/latency of PMwCAS implementations.");
   gflags::ParseCommandLineFlags(&argc, &argv, kRemoveParsedFlags);
+  if (FLAGS_metadata) {
+    ReportMetadata();
+    return 0;
+  }
 
   // parse command line arguments
   if (argc < 3) {
@@ -135,23 +1047,128 @@ main(  //
   }
   const auto target_num = std::stoull(argv[2]);
   constexpr auto kMax = ::dbgroup::pmem::atomic::kPMwCASCapacity;
-  if (target_num > kMax) {
-    std::cerr << "[Error] The current benchmark can swap up to " << kMax << " words.\n";
+  if (target_num > kMax || target_num > kMaxTargetNum) {
+    std::cerr << "[Error] The current benchmark can swap up to "
+              << std::min<size_t>(kMax, kMaxTargetNum) << " words.\n";
     return 1;
   }
+  if (FLAGS_words_per_group * kWordSize > FLAGS_block_size
+      || FLAGS_words_per_group > FLAGS_arr_cap) {
+    std::cerr << "[Error] The number of words per group exceeds a block or an array.\n";
+    return 1;
+  }
+  if (FLAGS_words_per_group > 1 && FLAGS_words_per_group < target_num) {
+    // co-located targets must fit in a block
+    std::cerr << "[Error] The number of words per group must not be less than target words.\n";
+    return 1;
+  }
+  const auto workload = (FLAGS_workload == "transfer") ? kTransfer : kIncrement;
+  if (workload == kTransfer && target_num < 2) {
+    std::cerr << "[Error] Transfer workloads require two or more target words.\n";
+    return 1;
+  }
+  if (FLAGS_num_process > 1 && FLAGS_microsoft_pmwcas) {
+    std::cerr << "[Error] The epochs of microsoft/pmwcas cannot be shared among processes.\n";
+    return 1;
+  }
+  if (FLAGS_contention_breakdown
+      && (FLAGS_num_process > 1 || FLAGS_prefetch_interleave > 1 || FLAGS_conflict_region > 0)) {
+    // positions in private partitions do not represent Zipf ranks
+    std::cerr << "[Error] Latency by contention cannot be collected with multiple processes, "
+                 "interleaving, or conflict control.\n";
+    return 1;
+  }
+  if (FLAGS_tsc_latency
+      && (FLAGS_num_process > 1 || FLAGS_prefetch_interleave > 1 || FLAGS_contention_breakdown
+          || FLAGS_pcas_ratio > 0)) {
+    std::cerr << "[Error] TSC latency cannot be combined with multiple processes, interleaving, "
+                 "latency by contention, or PCAS mixing.\n";
+    return 1;
+  }
+  if ((FLAGS_warmup > 0 || FLAGS_repeat > 1)
+      && (FLAGS_num_process > 1 || FLAGS_contention_breakdown || FLAGS_tsc_latency)) {
+    std::cerr << "[Error] Repetitions cannot be combined with multiple processes or latency "
+                 "histograms.\n";
+    return 1;
+  }
+  if ((FLAGS_warmup > 0 || FLAGS_repeat > 1) && !FLAGS_throughput) {
+    std::cerr << "[Error] Repetitions can be measured only in throughput mode.\n";
+    return 1;
+  }
+  if (FLAGS_tsc_latency && !TSCClock::IsInvariant()) {
+    std::cerr << "[Error] TSC latency requires a processor with an invariant TSC.\n";
+    return 1;
+  }
+  if (FLAGS_prefetch_interleave > 1 && !FLAGS_throughput) {
+    std::cerr << "[Error] Prefetch-only interleaving can be measured only in throughput mode.\n";
+    return 1;
+  }
+  if (FLAGS_conflict_region > 0
+      && (FLAGS_conflict_region < target_num || FLAGS_conflict_region > FLAGS_arr_cap
+          || (FLAGS_arr_cap - FLAGS_conflict_region) / FLAGS_num_thread < target_num)) {
+    std::cerr << "[Error] The shared region and each private partition must hold the target "
+                 "words of an operation.\n";
+    return 1;
+  }
+  if (FLAGS_conflict_region > 0 && (FLAGS_words_per_group > 1 || FLAGS_num_process > 1)) {
+    std::cerr << "[Error] Conflict control cannot be combined with groups of words or multiple "
+                 "processes.\n";
+    return 1;
+  }
+  if (FLAGS_conflict_region == 0 && FLAGS_conflict_ratio > 0) {
+    std::cerr << "[Error] A conflict ratio requires a shared region (--conflict_region).\n";
+    return 1;
+  }
+  if (FLAGS_value_mode == "pointer" && FLAGS_num_process > 1) {
+    std::cerr << "[Error] Nodes for pointer values cannot be allocated by multiple processes.\n";
+    return 1;
+  }
+  if (workload == kTransfer && FLAGS_pcas_ratio > 0) {
+    std::cerr << "[Error] PCAS operations can be mixed into increment workloads only.\n";
+    return 1;
+  }
+#ifndef PMWCAS_BENCH_EMULATE_PMEM
+  if (FLAGS_preempt_interval > 0) {
+    std::cerr << "[Error] Preemption requires hooks in persistence paths (build with "
+                 "-DPMWCAS_BENCH_EMULATE_PMEM=ON).\n";
+    return 1;
+  }
+#endif
+
+#ifdef PMWCAS_BENCH_EMULATE_PMEM
+  ConfigurePMEMDelay(FLAGS_flush_delay_ns, FLAGS_fence_delay_ns, FLAGS_read_delay_ns);
+  if (FLAGS_persist_mode == "clflush") {
+    SetPersistMode(kClflush);
+  } else if (FLAGS_persist_mode == "clflushopt") {
+    SetPersistMode(kClflushopt);
+  } else if (FLAGS_persist_mode == "clwb") {
+    SetPersistMode(kClwb);
+  } else if (FLAGS_persist_mode == "eadr") {
+    SetPersistMode(kEADR);
+  }
+#endif
 
   // run benchmark for each implementaton
   if (FLAGS_pmwcas) {
-    Run<PMwCAS>("PMwCAS", pmem_dir_str, target_num);
+    Run<PMwCAS>("PMwCAS", pmem_dir_str, target_num, workload);
+  }
+  if (FLAGS_pmwcas_dirty) {
+    Run<PMwCASDirty>("PMwCAS (dirty flag)", pmem_dir_str, target_num, workload);
   }
   if (FLAGS_microsoft_pmwcas) {
-    Run<MicrosoftPMwCAS>("microsoft/pmwcas", pmem_dir_str, target_num);
+    Run<MicrosoftPMwCAS>("microsoft/pmwcas", pmem_dir_str, target_num, workload);
   }
   if (FLAGS_pcas) {
     if (target_num > 1) {
       throw std::runtime_error{"PCAS cannot deal with multi-word swapping."};
     }
-    Run<PCAS>("PCAS", pmem_dir_str, target_num);
+    Run<PCAS>("PCAS", pmem_dir_str, target_num, workload);
+  }
+  if (FLAGS_lock) {
+    Run<LockMwCAS>("Lock", pmem_dir_str, target_num, workload);
+  }
+  if (FLAGS_null) {
+    Run<NullPMwCAS>("Null", pmem_dir_str, target_num, workload);
   }
 
   return 0;
@@ -0,0 +1,400 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// C++ standard libraries
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// external system libraries
+#include <gflags/gflags.h>
+
+// local sources
+#include "sample_stats.hpp"
+#include "validaters.hpp"
+
+/*##############################################################################
+ * Options for comparison
+ *############################################################################*/
+
+DEFINE_uint64(key_columns, 0,
+              "The number of leading columns that identify a setting (0: read them from a "
+              "\"# keys:\" line written by bin/measure_pmwcas.sh).");
+
+DEFINE_double(threshold, 0.05, "A relative change of a mean regarded as a regression.");
+DEFINE_validator(threshold, &ValidatePositiveVal);
+
+DEFINE_bool(higher_is_better, true,
+            "true: compare throughput (higher is better), false: compare latency. This applies "
+            "to untagged result lines only. If not given, results measured with "
+            "--throughput=false are compared as latency.");
+
+/*##############################################################################
+ * Formats of tagged lines
+ *############################################################################*/
+
+/**
+ * @brief A list of directions in which a metric column improves.
+ *
+ */
+enum Direction {
+  /// @brief A larger value is better (e.g., throughput).
+  kHigherIsBetter,
+  /// @brief A smaller value is better (e.g., latency and footprint).
+  kLowerIsBetter,
+  /// @brief A value describes a workload and is never judged (e.g., counts).
+  kNotJudged,
+};
+
+/**
+ * @brief The layout of result lines with a tag.
+ *
+ */
+struct LineFormat {
+  /// @brief The number of fields after a tag that identify a setting.
+  size_t key_num{0};
+
+  /// @brief The direction of each metric column.
+  std::vector<Direction> directions{};
+};
+
+/**
+ * @return The layouts of result lines tagged by pmwcas_bench and pmwcas_queue_bench.
+ */
+auto
+GetLineFormats()  //
+    -> const std::map<std::string, LineFormat> &
+{
+  constexpr auto kHigh = kHigherIsBetter;
+  constexpr auto kLow = kLowerIsBetter;
+  constexpr auto kNone = kNotJudged;
+
+  static const std::map<std::string, LineFormat> formats{
+      // throughput,thread_time,map_ms
+      {"process", {0, {kHigh, kLow, kLow}}},
+      // count,{mean,stddev,median,ci} of throughput,{mean,stddev,median,ci} of thread time
+      {"repetition", {0, {kNone, kHigh, kNone, kHigh, kNone, kLow, kNone, kLow, kNone}}},
+      // {count,derived throughput,average,p50,p90,p99} of PCAS, then of PMwCAS
+      {"op_type",
+       {0, {kNone, kHigh, kLow, kLow, kLow, kLow, kNone, kHigh, kLow, kLow, kLow, kLow}}},
+      // rank,retry | count,p50,p90,p99,p99.9
+      {"contention", {2, {kNone, kLow, kLow, kLow, kLow}}},
+      // count,p50,p90,p99,p99.9,p99.99,p99.999,max
+      {"tsc", {0, {kNone, kLow, kLow, kLow, kLow, kLow, kLow, kLow}}},
+      // configured | measured
+      {"conflict", {1, {kNone}}},
+      // scope | average,max
+      {"epoch", {1, {kLow, kLow}}},
+      // array,descriptors,capacity,rss,peak_rss
+      {"footprint", {0, {kLow, kLow, kNone, kLow, kLow}}},
+      // threads | milliseconds
+      {"generation", {1, {kLow}}},
+      // enqueued,dequeued,full,empty
+      {"queue", {0, {kNone, kNone, kNone, kNone}}},
+  };
+  return formats;
+}
+
+/*##############################################################################
+ * Utility classes and functions
+ *############################################################################*/
+
+/**
+ * @brief Benchmark results loaded from a CSV file.
+ *
+ */
+struct ResultSet {
+  /// @brief Metadata given by "# key: value" lines.
+  std::map<std::string, std::string> metadata{};
+
+  /// @brief The last value of each metadata key for skipping repeated lines.
+  std::map<std::string, std::string> last_metadata{};
+
+  /// @brief The number of leading columns that identify a setting.
+  size_t key_num{0};
+
+  /// @brief Settings in order of appearance.
+  std::vector<std::string> keys{};
+
+  /// @brief Samples of each metric column for each setting.
+  std::map<std::string, std::vector<SampleStats>> metrics{};
+
+  /// @brief The tag of each setting (empty for untagged lines).
+  std::map<std::string, std::string> tags{};
+};
+
+/**
+ * @param line A line of CSV.
+ * @return Comma-separated fields.
+ */
+auto
+Split(  //
+    const std::string &line)  //
+    -> std::vector<std::string>
+{
+  std::vector<std::string> fields{};
+  std::stringstream ss{line};
+  std::string field{};
+  while (std::getline(ss, field, ',')) {
+    fields.emplace_back(field);
+  }
+  return fields;
+}
+
+/**
+ * @param field A field of CSV.
+ * @retval true if the field represents a number.
+ * @retval false otherwise.
+ */
+auto
+IsNumber(  //
+    const std::string &field)  //
+    -> bool
+{
+  try {
+    std::stod(field);
+    return true;
+  } catch (const std::invalid_argument &) {
+    return false;
+  }
+}
+
+/**
+ * @param path The path to a CSV file of benchmark results.
+ * @return Metadata and samples in the file.
+ */
+auto
+LoadResults(  //
+    const std::string &path)  //
+    -> ResultSet
+{
+  std::ifstream file{path};
+  if (!file) throw std::runtime_error{"Failed to open " + path};
+
+  ResultSet results{};
+  std::string line{};
+  while (std::getline(file, line)) {
+    if (line.empty()) continue;
+    if (line[0] == '#') {
+      // metadata lines: "# key: value"
+      const auto pos = line.find(": ");
+      if (pos == std::string::npos) continue;
+      const auto &key = line.substr(2, pos - 2);
+      const auto &new_val = line.substr(pos + 2);
+      auto &val = results.metadata[key];
+      auto &last = results.last_metadata[key];
+      if (!val.empty() && new_val == last) continue;  // e.g., "persist_mode" of each run
+      val += (val.empty() ? "" : " ") + new_val;
+      last = new_val;
+      continue;
+    }
+
+    // key columns are given by an option or a "# keys:" line before results
+    auto &key_num = results.key_num;
+    if (key_num == 0) {
+      key_num = FLAGS_key_columns;
+      if (key_num == 0 && results.metadata.count("keys") > 0) {
+        key_num = Split(results.metadata.at("keys")).size();
+      }
+      if (key_num == 0) {
+        throw std::runtime_error{"No \"# keys:\" line precedes results in " + path
+                                 + " (use --key_columns)."};
+      }
+    }
+
+    const auto &fields = Split(line);
+    if (fields.size() <= key_num) continue;
+    std::string key{};
+    for (size_t i = 0; i < key_num; ++i) {
+      key += (i == 0 ? "" : ",") + fields[i];
+    }
+
+    // tagged lines (e.g., "conflict,...") are compared only with the same tag
+    auto head = key_num;
+    std::string tag{};
+    if (!IsNumber(fields[head])) {
+      tag = fields[head++];
+      key += "," + tag;
+      const auto &formats = GetLineFormats();
+      const auto extra_num = formats.count(tag) ? formats.at(tag).key_num : 0;
+      for (size_t i = 0; i < extra_num && head < fields.size(); ++i) {
+        key += "," + fields[head++];
+      }
+    }
+
+    auto [it, inserted] = results.metrics.try_emplace(key);
+    if (inserted) {
+      results.keys.emplace_back(key);
+      results.tags.emplace(key, tag);
+    }
+    auto &metrics = it->second;
+    metrics.resize(std::max(metrics.size(), fields.size() - head));
+    for (size_t i = head; i < fields.size(); ++i) {
+      try {
+        metrics[i - head].Add(std::stod(fields[i]));
+      } catch (const std::invalid_argument &) {
+        // skip non-numeric fields such as headers
+      }
+    }
+  }
+  return results;
+}
+
+/**
+ * @brief Output metadata that differ between two sets of results.
+ *
+ * @param base Baseline results.
+ * @param target Results to be compared.
+ */
+void
+ReportMetadataDiff(  //
+    const ResultSet &base,
+    const ResultSet &target)
+{
+  auto keys = base.metadata;
+  keys.insert(target.metadata.begin(), target.metadata.end());
+  for (const auto &[key, unused] : keys) {
+    const auto &b = base.metadata.count(key) ? base.metadata.at(key) : std::string{"-"};
+    const auto &t = target.metadata.count(key) ? target.metadata.at(key) : std::string{"-"};
+    if (b == t) continue;
+    std::cout << "# " << key << ": " << b << " -> " << t << "\n";
+  }
+}
+
+/**
+ * @param results Loaded results.
+ * @retval true if the results are measured with --throughput=false.
+ * @retval false otherwise.
+ */
+auto
+IsLatencyResult(  //
+    const ResultSet &results)  //
+    -> bool
+{
+  if (results.metadata.count("flag") == 0) return false;
+  return results.metadata.at("flag").find("--throughput=false") != std::string::npos;
+}
+
+/**
+ * @param tag The tag of a result line.
+ * @param column The position of a metric column.
+ * @param higher_is_better The direction of untagged lines.
+ * @return The direction in which the metric improves.
+ */
+auto
+GetDirection(  //
+    const std::string &tag,
+    const size_t column,
+    const bool higher_is_better)  //
+    -> Direction
+{
+  const auto &formats = GetLineFormats();
+  if (formats.count(tag) == 0) return (higher_is_better) ? kHigherIsBetter : kLowerIsBetter;
+
+  const auto &directions = formats.at(tag).directions;
+  return (column < directions.size()) ? directions[column] : kNotJudged;
+}
+
+/*##############################################################################
+ * Main procedure
+ *############################################################################*/
+
+auto
+main(  //
+    int argc,
+    char *argv[])  //
+    -> int
+{
+  // parse command line options
+  constexpr bool kRemoveParsedFlags = true;
+  gflags::SetUsageMessage("compares two sets of benchmark results.");
+  gflags::ParseCommandLineFlags(&argc, &argv, kRemoveParsedFlags);
+
+  // parse command line arguments
+  if (argc < 3) {
+    std::cerr << "Usage: ./pmwcas_compare <base_results.csv> <new_results.csv>\n";
+    return 1;
+  }
+  for (int i = 1; i < 3; ++i) {
+    if (!std::filesystem::is_regular_file(argv[i])) {
+      std::cerr << "[Error] The given path does not specify a file: " << argv[i] << "\n";
+      return 1;
+    }
+  }
+  ResultSet base{};
+  ResultSet target{};
+  try {
+    base = LoadResults(argv[1]);
+    target = LoadResults(argv[2]);
+  } catch (const std::runtime_error &e) {
+    std::cerr << "[Error] " << e.what() << "\n";
+    return 1;
+  }
+  if (base.key_num > 0 && target.key_num > 0 && base.key_num != target.key_num) {
+    std::cerr << "[Error] The files have different numbers of key columns.\n";
+    return 1;
+  }
+  auto higher_is_better = FLAGS_higher_is_better;
+  if (gflags::GetCommandLineFlagInfoOrDie("higher_is_better").is_default) {
+    higher_is_better = !IsLatencyResult(base);
+  }
+
+  // compare each metric of the settings in both sets
+  ReportMetadataDiff(base, target);
+  std::cout << "setting,metric,base_mean,new_mean,change,significant,verdict\n";
+  size_t regression_num = 0;
+  for (const auto &key : base.keys) {
+    if (target.metrics.count(key) == 0) continue;
+    const auto &b_metrics = base.metrics.at(key);
+    const auto &t_metrics = target.metrics.at(key);
+    for (size_t i = 0; i < b_metrics.size() && i < t_metrics.size(); ++i) {
+      const auto &b = b_metrics[i];
+      const auto &t = t_metrics[i];
+      if (b.GetCount() == 0 || t.GetCount() == 0) continue;
+
+      const auto b_mean = b.GetMean();
+      const auto t_mean = t.GetMean();
+      const auto change = (b_mean == 0) ? 0 : (t_mean - b_mean) / b_mean;
+      const auto direction = GetDirection(base.tags.at(key), i, higher_is_better);
+      const auto gain = (direction == kHigherIsBetter) ? change : -change;
+      const auto significant = SampleStats::DiffersSignificantly(b, t);
+      const auto judged = significant && direction != kNotJudged;
+      const auto *verdict = "-";
+      if (judged && gain < -FLAGS_threshold) {
+        verdict = "regression";
+        ++regression_num;
+      } else if (judged && gain > FLAGS_threshold) {
+        verdict = "improvement";
+      }
+
+      std::cout << "\"" << key << "\"," << i << "," << b_mean << "," << t_mean << "," << change
+                << "," << (significant ? "yes" : "no") << "," << verdict << "\n";
+    }
+  }
+
+  if (regression_num > 0) {
+    std::cerr << "[Warning] " << regression_num << " regressions are detected.\n";
+    return 2;
+  }
+  return 0;
+}
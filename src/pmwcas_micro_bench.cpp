@@ -0,0 +1,159 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// C++ standard libraries
+#include <cstddef>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+
+// external system libraries
+#include <gflags/gflags.h>
+
+// external libraries
+#include "benchmark/benchmarker.hpp"
+
+// local sources
+#include "common.hpp"
+#include "micro_operation_engine.hpp"
+#include "micro_target.hpp"
+#include "validaters.hpp"
+
+/*##############################################################################
+ * Options for selecting primitives
+ *############################################################################*/
+
+DEFINE_string(primitive, "pload",
+              "A building block to be measured: pload, pcas, pmwcas (Get/Add/PMwCAS), "
+              "microsoft_pmwcas (AllocateDescriptor/AddEntry/MwCAS), epoch "
+              "(Protect/Unprotect), or flush_fence (pmem_flush/pmem_drain).");
+DEFINE_validator(primitive, &ValidatePrimitive);
+
+DEFINE_string(sharing, "none",
+              "A placement of target words among workers: none (separate lines), false "
+              "(different words in the same lines), or true (the same words).");
+DEFINE_validator(sharing, &ValidateSharing);
+
+DEFINE_bool(dirty_lines, false,
+            "Modify target lines before each primitive so that they must be written back "
+            "again (this does not use the dirty-flag variant of our PMwCAS).");
+
+/*##############################################################################
+ * Options for controling workload
+ *############################################################################*/
+
+DEFINE_uint64(num_exec, 1000000, "The number of primitives executed by each worker.");
+DEFINE_validator(num_exec, &ValidateNonZero);
+
+DEFINE_uint64(num_thread, 1, "The number of worker threads for benchmarking.");
+DEFINE_validator(num_thread, &ValidateNonZero);
+
+/*##############################################################################
+ * Utility options
+ *############################################################################*/
+
+DEFINE_string(seed, "", "A random seed for reproducibility.");
+DEFINE_validator(seed, &ValidateRandomSeed);
+
+DEFINE_uint64(timeout, 10, "Timeout in seconds.");
+DEFINE_validator(timeout, &ValidateNonZero);
+
+DEFINE_bool(csv, false, "Output benchmark results as a CSV format.");
+
+DEFINE_bool(throughput, true, "true: measure throughput, false: measure latency.");
+
+/*##############################################################################
+ * Utility functions
+ *############################################################################*/
+
+/**
+ * @return A primitive specified by a command line option.
+ */
+auto
+GetPrimitive()  //
+    -> Primitive
+{
+  if (FLAGS_primitive == "pcas") return kPCAS;
+  if (FLAGS_primitive == "pmwcas") return kPMwCASDesc;
+  if (FLAGS_primitive == "microsoft_pmwcas") return kMicrosoftDesc;
+  if (FLAGS_primitive == "epoch") return kEpoch;
+  if (FLAGS_primitive == "flush_fence") return kFlushFence;
+  return kPLoad;
+}
+
+/**
+ * @return A placement of target words specified by a command line option.
+ */
+auto
+GetSharing()  //
+    -> Sharing
+{
+  if (FLAGS_sharing == "false") return kFalseSharing;
+  if (FLAGS_sharing == "true") return kTrueSharing;
+  return kNoSharing;
+}
+
+/*##############################################################################
+ * Main procedure
+ *############################################################################*/
+
+auto
+main(  //
+    int argc,
+    char *argv[])  //
+    -> int
+{
+  using Bench_t = ::dbgroup::benchmark::Benchmarker<MicroTarget, MicroOperation,  //
+                                                    MicroOperationEngine>;
+  constexpr auto kPercentile = "0.01,0.05,0.10,0.20,0.30,0.40,0.50,0.60,0.70,0.80,0.90,0.95,0.99";
+
+  // parse command line options
+  constexpr bool kRemoveParsedFlags = true;
+  gflags::SetUsageMessage("measures throughput/latency of building blocks of PMwCAS.");
+  gflags::ParseCommandLineFlags(&argc, &argv, kRemoveParsedFlags);
+
+  // parse command line arguments
+  if (argc < 2) {
+    std::cerr << "Usage: ./pmwcas_micro_bench --primitive=<name> <path_to_pmem_dir> "
+                 "[<target_word_num>]\n";
+    return 1;
+  }
+  const std::string pmem_dir_str{argv[1]};
+  if (!std::filesystem::exists(pmem_dir_str) || !std::filesystem::is_directory(pmem_dir_str)) {
+    std::cerr << "[Error] The given path does not specify a directory.\n";
+    return 1;
+  }
+  const size_t target_num = (argc > 2) ? std::stoull(argv[2]) : 1;
+  if (target_num == 0 || target_num > kMaxTargetNum) {
+    std::cerr << "[Error] The number of target words must be in [1, " << kMaxTargetNum << "].\n";
+    return 1;
+  }
+
+  // run a microbenchmark
+  const auto random_seed = (FLAGS_seed.empty()) ? std::random_device{}()  //
+                                                : std::stoul(FLAGS_seed);
+  const auto &name = FLAGS_primitive + " (" + FLAGS_sharing + " sharing"
+                     + (FLAGS_dirty_lines ? ", dirty lines)" : ")");
+  MicroTarget target{pmem_dir_str, GetPrimitive(),    GetSharing(),
+                     target_num,   FLAGS_dirty_lines, FLAGS_num_thread};
+  MicroOperationEngine ops_engine{};
+  Bench_t bench{target,      name,             ops_engine, FLAGS_num_exec, FLAGS_num_thread,
+                random_seed, FLAGS_throughput, FLAGS_csv,  FLAGS_timeout,  kPercentile};
+  bench.Run();
+
+  return 0;
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// C++ standard libraries
+#include <cstddef>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+// external system libraries
+#include <gflags/gflags.h>
+
+// external libraries
+#include "benchmark/benchmarker.hpp"
+
+// local sources
+#include "common.hpp"
+#include "competitor.hpp"
+#include "contention_manager.hpp"
+#include "queue_operation_engine.hpp"
+#include "queue_target.hpp"
+#include "validaters.hpp"
+
+/*##############################################################################
+ * Options for selecting competitors
+ *############################################################################*/
+
+DEFINE_bool(pmwcas, false, "Use our PMwCAS as a competitor.");
+
+DEFINE_bool(microsoft_pmwcas, false, "Use a microsoft/pmwcas as a competitor.");
+
+DEFINE_bool(lock, false, "Use a blocking baseline with striped spinlocks as a competitor.");
+
+DEFINE_string(contention_manager, "none",
+              "A policy for failed attempts: none (retry immediately), exponential (backoff), "
+              "randomized (backoff), or adaptive (backoff only under high failure rates).");
+DEFINE_validator(contention_manager, &ValidateContentionManager);
+
+/*##############################################################################
+ * Options for controling workload
+ *############################################################################*/
+
+DEFINE_uint64(num_exec, 1000000, "The number of operations executed by each worker.");
+DEFINE_validator(num_exec, &ValidateNonZero);
+
+DEFINE_uint64(num_thread, 1, "The number of worker threads for benchmarking.");
+DEFINE_validator(num_thread, &ValidateNonZero);
+
+DEFINE_uint64(num_producer, 0,
+              "The number of workers that only enqueue elements, while the others only dequeue "
+              "them (0: every worker alternates enqueue and dequeue).");
+
+DEFINE_uint64(capacity, 1UL << 16UL, "The number of slots in a queue (a power of two).");
+DEFINE_validator(capacity, &ValidatePowerOfTwo);
+
+DEFINE_uint64(prefill, 1UL << 15UL, "The number of elements enqueued before benchmarking.");
+
+/*##############################################################################
+ * Utility options
+ *############################################################################*/
+
+DEFINE_string(seed, "", "A random seed for reproducibility.");
+DEFINE_validator(seed, &ValidateRandomSeed);
+
+DEFINE_uint64(timeout, 10, "Timeout in seconds.");
+DEFINE_validator(timeout, &ValidateNonZero);
+
+DEFINE_bool(csv, false, "Output benchmark results as a CSV format.");
+
+DEFINE_bool(throughput, true, "true: measure throughput, false: measure latency.");
+
+DEFINE_bool(verify, true, "Check the elements left in a queue after each run.");
+
+/*##############################################################################
+ * Utility functions
+ *############################################################################*/
+
+/**
+ * @return A policy for failed attempts specified by a command line option.
+ */
+auto
+GetContentionPolicy()  //
+    -> ContentionPolicy
+{
+  if (FLAGS_contention_manager == "exponential") return kExponentialBackoff;
+  if (FLAGS_contention_manager == "randomized") return kRandomizedBackoff;
+  if (FLAGS_contention_manager == "adaptive") return kAdaptiveBackoff;
+  return kNoBackoff;
+}
+
+/**
+ * @brief Output the numbers of executed operations by their results.
+ *
+ * @param stats The numbers of executed operations.
+ */
+void
+ReportQueueStats(  //
+    const QueueStats &stats)
+{
+  if (FLAGS_csv) {
+    std::cout << "queue," << stats.enqueue_num << "," << stats.dequeue_num << ","
+              << stats.full_num << "," << stats.empty_num << "\n";
+  } else {
+    std::cout << "Queue operations:\n"
+              << "  Enqueued: " << stats.enqueue_num << "\n"
+              << "  Dequeued: " << stats.dequeue_num << "\n"
+              << "  Full:     " << stats.full_num << "\n"
+              << "  Empty:    " << stats.empty_num << "\n";
+  }
+}
+
+/**
+ * @brief Run procedures for benchmarking with a given implementation.
+ *
+ * @tparam Implementation an implementation to be benchmarked.
+ * @param target_name the output name of a implementation.
+ * @param pmem_dir_str the path to persistent memory.
+ */
+template <class Implementation>
+void
+Run(  //
+    const std::string &target_name,
+    const std::string &pmem_dir_str)
+{
+  using Target_t = QueueTarget<Implementation>;
+  using Bench_t = ::dbgroup::benchmark::Benchmarker<Target_t, QueueOperation,  //
+                                                    QueueOperationEngine>;
+  constexpr auto kPercentile =
+      "0.01,0.05,0.10,0.20,0.30,0.40,0.50,0.60,0.70,0.80,0.90,0.95,0.99,0.999";
+
+  const auto random_seed = (FLAGS_seed.empty()) ? std::random_device{}()  //
+                                                : std::stoul(FLAGS_seed);
+  Target_t target{pmem_dir_str, FLAGS_capacity, FLAGS_prefill};
+  target.SetContentionPolicy(GetContentionPolicy());
+  QueueOperationEngine ops_engine{FLAGS_num_producer};
+  Bench_t bench{target,      target_name,      ops_engine, FLAGS_num_exec, FLAGS_num_thread,
+                random_seed, FLAGS_throughput, FLAGS_csv,  FLAGS_timeout,  kPercentile};
+  bench.Run();
+
+  // check the elements left in a queue to detect broken atomicity
+  if (FLAGS_verify && !target.Verify()) {
+    throw std::runtime_error{"The elements in a queue are inconsistent with operations."};
+  }
+  ReportQueueStats(target.GetStats());
+}
+
+/*##############################################################################
+ * Main procedure
+ *############################################################################*/
+
+auto
+main(  //
+    int argc,
+    char *argv[])  //
+    -> int
+{
+  // parse command line options
+  constexpr bool kRemoveParsedFlags = true;
+  gflags::SetUsageMessage("measures throughput/latency of persistent queues built with PMwCAS.");
+  gflags::ParseCommandLineFlags(&argc, &argv, kRemoveParsedFlags);
+
+  // parse command line arguments
+  if (argc < 2) {
+    std::cerr << "Usage: ./pmwcas_queue_bench [--pmwcas|--microsoft_pmwcas|--lock] "
+                 "<path_to_pmem_dir>\n";
+    return 1;
+  }
+  const std::string pmem_dir_str{argv[1]};
+  if (!std::filesystem::exists(pmem_dir_str) || !std::filesystem::is_directory(pmem_dir_str)) {
+    std::cerr << "[Error] The given path does not specify a directory.\n";
+    return 1;
+  }
+  if (FLAGS_prefill > FLAGS_capacity) {
+    std::cerr << "[Error] The number of initial elements exceeds the capacity of a queue.\n";
+    return 1;
+  }
+  if (FLAGS_num_producer > FLAGS_num_thread) {
+    std::cerr << "[Error] The number of producers exceeds the number of workers.\n";
+    return 1;
+  }
+
+  // run benchmark for each implementaton
+  if (FLAGS_pmwcas) {
+    Run<PMwCAS>("PMwCAS", pmem_dir_str);
+  }
+  if (FLAGS_microsoft_pmwcas) {
+    Run<MicrosoftPMwCAS>("microsoft/pmwcas", pmem_dir_str);
+  }
+  if (FLAGS_lock) {
+    Run<LockMwCAS>("Lock", pmem_dir_str);
+  }
+
+  return 0;
+}
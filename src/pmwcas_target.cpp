@@ -18,18 +18,35 @@
 #include "pmwcas_target.hpp"
 
 // C++ standard libraries
+#include <algorithm>
 #include <atomic>
+#include <cassert>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 // system headers
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 // external system libraries
+#include <libpmem.h>
 #include <libpmemobj.h>
 
 // external libraries
@@ -40,6 +57,9 @@
 #include "common.hpp"
 #include "competitor.hpp"
 #include "operation.hpp"
+#include "pmem_emulator.hpp"
+#include "tsc_clock.hpp"
+#include "value_codec.hpp"
 
 namespace
 {
@@ -59,12 +79,146 @@ constexpr char kMicrosoftPMwCASName[] = "microsoft_pmwcas";
 /// @brief A layout name for benchmarking with arrays.
 constexpr char kArrayName[] = "array";
 
+/// @brief A layout name for nodes referred to by pointer values.
+constexpr char kNodeName[] = "node";
+
+/// @brief The default size of a pool for microsoft/pmwcas descriptors (8GB).
+constexpr size_t kDefaultPoolSize = PMEMOBJ_MIN_POOL * 1024;
+
+/// @brief The default number of partitions for microsoft/pmwcas descriptors.
+constexpr uint32_t kDefaultPartition = DBGROUP_MAX_THREAD_NUM;
+
+/// @brief The default number of microsoft/pmwcas descriptors in each partition.
+constexpr uint32_t kDefaultDescPerPartition = 1024;
+
 /// @brief File permission for pmemobj_pool.
 constexpr auto kModeRW = S_IRUSR | S_IWUSR;  // NOLINT
 
 /// @brief An alias of std::memory_order_relaxed.
 constexpr std::memory_order kMORelax = std::memory_order_relaxed;
 
+/// @brief The number of independent accumulators for scanning an array.
+constexpr size_t kScanUnrollNum = 8;
+
+/*##############################################################################
+ * Local variables
+ *############################################################################*/
+
+/// @brief A counter for assigning unique IDs to target objects.
+std::atomic_size_t target_id_counter{0};
+
+/*##############################################################################
+ * Local utilities
+ *############################################################################*/
+
+/**
+ * @brief Split a range of positions and process them with multiple threads.
+ *
+ * @tparam Func A function type that receives a half-open range [begin, end).
+ * @param n The number of positions.
+ * @param thread_num The number of threads.
+ * @param func A function to process each range.
+ */
+template <class Func>
+void
+ForEachRangeInParallel(  //
+    const size_t n,
+    const size_t thread_num,
+    Func &&func)
+{
+  std::vector<std::thread> threads{};
+  threads.reserve(thread_num);
+  for (size_t i = 0; i < thread_num; ++i) {
+    const auto begin = n * i / thread_num;
+    const auto end = n * (i + 1) / thread_num;
+    threads.emplace_back(func, i, begin, end);
+  }
+  for (auto &&t : threads) t.join();
+}
+
+/**
+ * @brief A shared mapping of a file in the address space of this process.
+ *
+ */
+struct FileMapping {
+  /// @brief The head address of a mapping.
+  void *addr{nullptr};
+
+  /// @brief The length of a mapping in bytes.
+  size_t len{0};
+
+  /// @brief The offset of a mapping in a file.
+  off_t offset{0};
+
+  /// @brief Memory protection of a mapping.
+  int prot{PROT_NONE};
+
+  /// @brief The path to a mapped file.
+  std::string path{};
+};
+
+/**
+ * @param dir_str A directory of pool files.
+ * @return The shared mappings of files in the directory.
+ */
+auto
+GetFileMappings(  //
+    const std::string &dir_str)  //
+    -> std::vector<FileMapping>
+{
+  const auto &dir = std::filesystem::canonical(dir_str).string() + "/";
+  std::vector<FileMapping> mappings{};
+  std::ifstream maps{"/proc/self/maps"};
+  for (std::string line{}; std::getline(maps, line);) {
+    // each line has "begin-end perms offset dev inode path"
+    std::istringstream in{line};
+    std::string range{};
+    std::string perms{};
+    std::string offset{};
+    std::string dev{};
+    std::string inode{};
+    std::string path{};
+    in >> range >> perms >> offset >> dev >> inode;
+    std::getline(in >> std::ws, path);
+    if (path.compare(0, dir.size(), dir) != 0 || perms.size() < 4 || perms[3] != 's') continue;
+
+    const auto sep = range.find('-');
+    const auto begin = std::stoull(range.substr(0, sep), nullptr, 16);
+    const auto end = std::stoull(range.substr(sep + 1), nullptr, 16);
+    const int prot = ((perms[0] == 'r') ? PROT_READ : 0) | ((perms[1] == 'w') ? PROT_WRITE : 0);
+    mappings.emplace_back(FileMapping{reinterpret_cast<void *>(begin), end - begin,
+                                      static_cast<off_t>(std::stoull(offset, nullptr, 16)), prot,
+                                      path});
+  }
+  return mappings;
+}
+
+/**
+ * @brief Replace a mapping with a new one of the same file at the same address.
+ *
+ * @param mapping A mapping to be replaced.
+ */
+void
+MapFileAgain(  //
+    const FileMapping &mapping)
+{
+  const auto fd = open(mapping.path.c_str(), (mapping.prot & PROT_WRITE) ? O_RDWR : O_RDONLY);
+  if (fd < 0) throw std::runtime_error{"Failed to open a pool file: " + mapping.path};
+
+  constexpr int kFlags = MAP_FIXED | MAP_POPULATE;
+  auto *addr = MAP_FAILED;
+#ifdef MAP_SYNC
+  // map files on DAX file systems as libpmemobj does
+  addr = mmap(mapping.addr, mapping.len, mapping.prot,  //
+              MAP_SHARED_VALIDATE | MAP_SYNC | kFlags, fd, mapping.offset);
+#endif
+  if (addr == MAP_FAILED) {
+    addr = mmap(mapping.addr, mapping.len, mapping.prot, MAP_SHARED | kFlags, fd, mapping.offset);
+  }
+  close(fd);
+  if (addr == MAP_FAILED) throw std::runtime_error{"Failed to map a pool file: " + mapping.path};
+}
+
 }  // namespace
 
 /*##############################################################################
@@ -75,59 +229,145 @@ template <>
 PMwCASTarget<PMwCAS>::PMwCASTarget(  //
     const std::string &pmem_dir_str,
     const size_t array_cap,
-    const size_t block_size)
-    : block_size_{block_size}
+    const size_t block_size,
+    const size_t words_per_group,
+    const size_t segment_size,
+    [[maybe_unused]] const DescPoolConfig &desc_config)
+    : array_cap_{array_cap}, block_size_{block_size}, words_per_group_{words_per_group}
 {
-  Initialize(pmem_dir_str, array_cap);
+  Initialize(pmem_dir_str, array_cap, segment_size);
 
   // prepare descriptor pool for PMwCAS
   const auto &pmwcas_path = GetPath(pmem_dir_str_, kPMwCASName);
   desc_pool_ = std::make_unique<PMwCAS>(pmwcas_path, kPMwCASName);
+  desc_capacity_ = DBGROUP_MAX_THREAD_NUM;
 }
 
+// the dirty-flag variant only defines our PMwCAS (see CMakeLists.txt)
+#ifndef PMWCAS_BENCH_DIRTY_VARIANT
+
 template <>
 PMwCASTarget<MicrosoftPMwCAS>::PMwCASTarget(  //
     const std::string &pmem_dir_str,
     const size_t array_cap,
-    const size_t block_size)
-    : block_size_{block_size}
+    const size_t block_size,
+    const size_t words_per_group,
+    const size_t segment_size,
+    const DescPoolConfig &desc_config)
+    : array_cap_{array_cap}, block_size_{block_size}, words_per_group_{words_per_group}
 {
-  Initialize(pmem_dir_str, array_cap);
+  Initialize(pmem_dir_str, array_cap, segment_size);
 
   // prepare descriptor pool for PMwCAS
   const auto &pmwcas_path = GetPath(pmem_dir_str_, kMicrosoftPMwCASName);
-  constexpr auto kPoolSize = PMEMOBJ_MIN_POOL * 1024;  // 8GB
-  constexpr uint32_t kPartition = DBGROUP_MAX_THREAD_NUM;
-  constexpr uint32_t kPoolCapacity = kPartition * 1024;
+  const auto pool_size = (desc_config.pool_size > 0) ? desc_config.pool_size : kDefaultPoolSize;
+  const size_t partition = (desc_config.partition > 0) ? desc_config.partition  //
+                                                       : kDefaultPartition;
+  const size_t capacity = (desc_config.capacity > 0) ? desc_config.capacity
+                                                     : partition * kDefaultDescPerPartition;
+  if (capacity > std::numeric_limits<uint32_t>::max()) {
+    throw std::out_of_range{"The number of descriptors must fit in 32 bits."};
+  }
+  if (capacity < partition) {
+    throw std::runtime_error{"The number of descriptors must not be less than partitions."};
+  }
 
   ::pmwcas::InitLibrary(
-      pmwcas::PMDKAllocator::Create(pmwcas_path.c_str(), kMicrosoftPMwCASName, kPoolSize),
+      pmwcas::PMDKAllocator::Create(pmwcas_path.c_str(), kMicrosoftPMwCASName, pool_size),
       pmwcas::PMDKAllocator::Destroy,    //
       pmwcas::LinuxEnvironment::Create,  //
       pmwcas::LinuxEnvironment::Destroy);
-  desc_pool_ = std::make_unique<MicrosoftPMwCAS>(kPoolCapacity, kPartition);
+  desc_pool_ = std::make_unique<MicrosoftPMwCAS>(static_cast<uint32_t>(capacity),
+                                                 static_cast<uint32_t>(partition));
+  desc_capacity_ = capacity;
 }
 
 template <>
 PMwCASTarget<PCAS>::PMwCASTarget(  //
     const std::string &pmem_dir_str,
     const size_t array_cap,
-    const size_t block_size)
-    : block_size_{block_size}
+    const size_t block_size,
+    const size_t words_per_group,
+    const size_t segment_size,
+    [[maybe_unused]] const DescPoolConfig &desc_config)
+    : array_cap_{array_cap}, block_size_{block_size}, words_per_group_{words_per_group}
+{
+  Initialize(pmem_dir_str, array_cap, segment_size);
+}
+
+template <>
+PMwCASTarget<LockMwCAS>::PMwCASTarget(  //
+    const std::string &pmem_dir_str,
+    const size_t array_cap,
+    const size_t block_size,
+    const size_t words_per_group,
+    const size_t segment_size,
+    [[maybe_unused]] const DescPoolConfig &desc_config)
+    : array_cap_{array_cap}, block_size_{block_size}, words_per_group_{words_per_group}
 {
-  Initialize(pmem_dir_str, array_cap);
+  Initialize(pmem_dir_str, array_cap, segment_size);
+  desc_pool_ = std::make_unique<LockMwCAS>();
 }
 
+template <>
+PMwCASTarget<NullPMwCAS>::PMwCASTarget(  //
+    const std::string &pmem_dir_str,
+    const size_t array_cap,
+    const size_t block_size,
+    const size_t words_per_group,
+    const size_t segment_size,
+    [[maybe_unused]] const DescPoolConfig &desc_config)
+    : array_cap_{array_cap}, block_size_{block_size}, words_per_group_{words_per_group}
+{
+  Initialize(pmem_dir_str, array_cap, segment_size);
+}
+
+#endif
+
 template <class Implementation>
 PMwCASTarget<Implementation>::~PMwCASTarget()
 {
   desc_pool_ = nullptr;
-  if (pop_ != nullptr) {
-    pmemobj_close(pop_);
+  proc_desc_pools_.clear();
+  for (auto *pop : pops_) {
+    pmemobj_close(pop);
+  }
+  if (node_pop_ != nullptr) {
+    pmemobj_close(node_pop_);
   }
   std::filesystem::remove_all(pmem_dir_str_);
 }
 
+/*##############################################################################
+ * Setup/Teardown for workers
+ *############################################################################*/
+
+template <class Implementation>
+void
+PMwCASTarget<Implementation>::TearDownForWorker()
+{
+  auto &stats = GetWorkerStats();
+
+  // complete the operations left in flight when a worker stops early (e.g., by timeout)
+  if (interleave_width_ > 1) {
+    (this->*funcs_.drain)(stats);
+  }
+
+  if (measure_tsc_latency_) {
+    tsc_hist_.MergeAtomically(*stats.tsc_hist);
+    *stats.tsc_hist = HDRHistogram{};
+  }
+
+#ifndef PMWCAS_BENCH_DIRTY_VARIANT
+  if constexpr (std::is_same_v<Implementation, MicrosoftPMwCAS>) {
+    // leave an epoch that spans a whole worker run
+    if (stats.in_epoch) {
+      LeaveEpoch(*desc_pool_, stats, true);
+    }
+  }
+#endif
+}
+
 /*##############################################################################
  * Public APIs
  *############################################################################*/
@@ -138,71 +378,302 @@ PMwCASTarget<Implementation>::GetValue(  //
     const size_t pos) const              //
     -> uint64_t
 {
-  const void *addr = root_addr_ + (pos << shift_num_);
-  return reinterpret_cast<const std::atomic_uint64_t *>(addr)->load(kMORelax);
+  const void *addr = GetAddr(pos);
+  return Decode(reinterpret_cast<const std::atomic_uint64_t *>(addr)->load(kMORelax));
 }
 
-template <>
-auto
-PMwCASTarget<PMwCAS>::Execute(  //
-    const Operation &ops)       //
-    -> size_t
+template <class Implementation>
+void
+PMwCASTarget<Implementation>::Fill(  //
+    const uint64_t val,
+    const size_t thread_num)
 {
-  const auto &positions = ops.GetPositions();
-  while (true) {
-    auto *desc = desc_pool_->Get();
-    for (const auto pos : positions) {
+  ForEachRangeInParallel(array_cap_, thread_num, [&](size_t, size_t begin, size_t end) {
+    for (size_t pos = begin; pos < end; ++pos) {
       auto *addr = GetAddr(pos);
-      const auto old_val = ::dbgroup::pmem::atomic::PLoad(addr, kMORelax);
-      desc->Add(addr, old_val, old_val + 1, kMORelax);
+      if (value_mode_ == kPointerValue) {
+        // the first nodes are reserved for initial values
+        auto *node = GetNode(pos);
+        *node = val;
+        pmem_flush(node, sizeof(uint64_t));
+        *addr = reinterpret_cast<uint64_t>(node);
+      } else {
+        *addr = Encode(val);
+      }
+      pmem_flush(addr, sizeof(uint64_t));
     }
-    if (desc->PMwCAS()) break;
+    pmem_drain();
+  });
+}
+
+template <class Implementation>
+auto
+PMwCASTarget<Implementation>::Sum(  //
+    const size_t thread_num) const  //
+    -> uint64_t
+{
+  if (value_mode_ != kCounterValue) {
+    // encoded values are decoded one by one
+    std::vector<uint64_t> partial_sums(thread_num, 0);
+    ForEachRangeInParallel(array_cap_, thread_num, [&](size_t i, size_t begin, size_t end) {
+      uint64_t sum = 0;
+      for (size_t pos = begin; pos < end; ++pos) {
+        sum += GetValue(pos);
+      }
+      partial_sums[i] = sum;
+    });
+
+    uint64_t sum = 0;
+    for (const auto partial_sum : partial_sums) {
+      sum += partial_sum;
+    }
+    return sum;
   }
 
-  return 1;
+  // workers have finished, so scan the array without atomic loads
+  const auto stride = block_size_ / kWordSize;
+  const auto group = words_per_group_;
+  const auto block_num = array_cap_ / group;
+  const auto seg_blocks = 1UL << seg_shift_;
+
+  std::vector<uint64_t> partial_sums(thread_num, 0);
+  ForEachRangeInParallel(block_num, thread_num, [&](size_t i, size_t begin, size_t end) {
+    // use independent accumulators to let compilers vectorize the loop
+    uint64_t sums[kScanUnrollNum] = {};
+    for (auto block = begin; block < end;) {
+      // scan contiguous blocks in each segment
+      const auto seg_end = std::min(((block >> seg_shift_) + 1) * seg_blocks, end);
+      const auto *words = reinterpret_cast<const uint64_t *>(seg_addrs_[block >> seg_shift_]);
+      words += (block & (seg_blocks - 1)) * stride;
+      for (; block + kScanUnrollNum <= seg_end; block += kScanUnrollNum) {
+        for (size_t j = 0; j < kScanUnrollNum; ++j) {
+          for (size_t k = 0; k < group; ++k) {
+            sums[j] += words[j * stride + k];
+          }
+        }
+        words += kScanUnrollNum * stride;
+      }
+      for (; block < seg_end; ++block) {
+        for (size_t k = 0; k < group; ++k) {
+          sums[0] += words[k];
+        }
+        words += stride;
+      }
+    }
+
+    uint64_t sum = 0;
+    for (const auto partial_sum : sums) {
+      sum += partial_sum;
+    }
+    partial_sums[i] = sum;
+  });
+
+  // the last block may be partially used
+  uint64_t sum = 0;
+  for (size_t pos = block_num * group; pos < array_cap_; ++pos) {
+    sum += GetValue(pos);
+  }
+  for (const auto partial_sum : partial_sums) {
+    sum += partial_sum;
+  }
+  return sum;
 }
 
-template <>
+template <class Implementation>
 auto
-PMwCASTarget<MicrosoftPMwCAS>::Execute(  //
-    const Operation &ops)                //
+PMwCASTarget<Implementation>::GetArrayFileSize() const  //
     -> size_t
 {
-  using PMwCASField = ::pmwcas::MwcTargetField<uint64_t>;
+  size_t size = 0;
+  for (const auto &path : array_paths_) {
+    size += std::filesystem::file_size(path);
+  }
+  return size;
+}
 
-  const auto &positions = ops.GetPositions();
-  auto *epoch = desc_pool_->GetEpoch();
-  epoch->Protect();
-  while (true) {
-    auto *desc = desc_pool_->AllocateDescriptor();
-    for (const auto pos : positions) {
-      auto *addr = GetAddr(pos);
-      const auto old_val = reinterpret_cast<PMwCASField *>(addr)->GetValueProtected();
-      desc->AddEntry(addr, old_val, old_val + 1);
+template <class Implementation>
+auto
+PMwCASTarget<Implementation>::GetDescPoolFileSize() const  //
+    -> size_t
+{
+  size_t size = 0;
+  for (const auto &entry : std::filesystem::recursive_directory_iterator{pmem_dir_str_}) {
+    if (!entry.is_regular_file()) continue;
+    size += entry.file_size();
+  }
+  if (!node_path_.empty()) {
+    size -= std::filesystem::file_size(node_path_);
+  }
+  return size - GetArrayFileSize();
+}
+
+template <class Implementation>
+void
+PMwCASTarget<Implementation>::PrepareProcesses(  //
+    const size_t process_num)
+{
+  if constexpr (std::is_same_v<Implementation, PMwCAS>) {
+    // workers in different processes may have the same thread IDs
+    for (size_t i = 1; i < process_num; ++i) {
+      const auto &name = std::string{kPMwCASName} + "_" + std::to_string(i);
+      const auto &path = GetPath(pmem_dir_str_, name);
+      proc_desc_pools_.emplace_back(std::make_unique<PMwCAS>(path, kPMwCASName));
     }
-    if (desc->MwCAS()) break;
+    desc_capacity_ = DBGROUP_MAX_THREAD_NUM * process_num;
+#ifndef PMWCAS_BENCH_DIRTY_VARIANT
+  } else if constexpr (std::is_same_v<Implementation, MicrosoftPMwCAS>) {
+    throw std::runtime_error{"The epochs and descriptor allocator of microsoft/pmwcas are "
+                             "private to each process."};
+#endif
   }
-  epoch->Unprotect();
+}
 
-  return 1;
+template <class Implementation>
+void
+PMwCASTarget<Implementation>::AttachProcess(  //
+    [[maybe_unused]] const size_t process_id)
+{
+  if constexpr (std::is_same_v<Implementation, PMwCAS>) {
+    if (process_id > 0) {
+      desc_pool_.swap(proc_desc_pools_.at(process_id - 1));
+    }
+  }
+
+  // collect mappings before replacing them
+  const auto &mappings = GetFileMappings(pmem_dir_str_);
+  if (mappings.empty()) throw std::runtime_error{"No pool files are mapped."};
+  for (const auto &mapping : mappings) {
+    MapFileAgain(mapping);
+  }
 }
 
-template <>
+template <class Implementation>
+auto
+PMwCASTarget<Implementation>::GetExecNum() const  //
+    -> size_t
+{
+  size_t exec_num = 0;
+  for (const auto &stats : stats_) {
+    exec_num += stats->exec_num;
+  }
+  return exec_num;
+}
+
+template <class Implementation>
 auto
-PMwCASTarget<PCAS>::Execute(  //
-    const Operation &ops)     //
+PMwCASTarget<Implementation>::GetConflictNum() const  //
     -> size_t
 {
-  const auto &positions = ops.GetPositions();
-  assert(positions.size() == 1);
+  size_t sum = 0;
+  for (const auto &stats : stats_) {
+    sum += stats->conflict_num;
+  }
+  return sum;
+}
 
-  auto *addr = GetAddr(positions.front());
-  auto old_val = ::dbgroup::pmem::atomic::PLoad(addr, kMORelax);
-  while (!::dbgroup::pmem::atomic::PCAS(addr, old_val, old_val + 1, kMORelax, kMORelax)) {
-    // continue until PCAS succeeds
+template <class Implementation>
+auto
+PMwCASTarget<Implementation>::GetOpTypeStats() const  //
+    -> OpTypeStats
+{
+  OpTypeStats sum{};
+  for (const auto &stats : stats_) {
+    sum.Merge(stats->types);
   }
+  return sum;
+}
 
-  return 1;
+template <class Implementation>
+auto
+PMwCASTarget<Implementation>::GetEpochLag() const  //
+    -> EpochLag
+{
+  EpochLag sum{};
+  for (const auto &stats : stats_) {
+    sum.sample_num += stats->epoch_lag.sample_num;
+    sum.sum += stats->epoch_lag.sum;
+    sum.max = std::max(sum.max, stats->epoch_lag.max);
+  }
+  return sum;
+}
+
+template <class Implementation>
+auto
+PMwCASTarget<Implementation>::GetContentionHistograms() const  //
+    -> std::vector<LatencyHistogram>
+{
+  std::vector<LatencyHistogram> sum(kRankClassNum * kRetryClassNum);
+  for (const auto &stats : stats_) {
+    for (size_t i = 0; i < stats->hists.size(); ++i) {
+      sum[i].Merge(stats->hists[i]);
+    }
+  }
+  return sum;
+}
+
+template <class Implementation>
+void
+PMwCASTarget<Implementation>::SetValueMode(  //
+    const ValueMode mode,
+    const size_t node_num)
+{
+  value_mode_ = mode;
+  uint64_t value_bits = 0;
+  if (mode == kRandomValue) {
+    value_bits = kRandomValueMask;
+  } else if (mode == kReservedValue) {
+    reserved_pattern_ = GetReservedPattern(kReservedBits<Implementation>);
+  } else if (mode == kPointerValue) {
+    // prepare nodes for initial values and those allocated by workers
+    node_capacity_ = array_cap_ + node_num;
+    node_cursor_ = array_cap_;
+    const auto nodes_size = kCacheLineSize * (node_capacity_ + 1);
+    node_path_ = GetPath(pmem_dir_str_, kNodeName);
+    node_pop_ = pmemobj_create(node_path_.c_str(), kNodeName, nodes_size + PMEMOBJ_MIN_POOL,
+                               kModeRW);
+    if (node_pop_ == nullptr) throw std::runtime_error{pmemobj_errormsg()};
+
+    auto &&root = pmemobj_root(node_pop_, nodes_size);
+    if (root.off == 0) {
+      throw std::runtime_error{"Failed to allocate nodes: " + std::string{pmemobj_errormsg()}};
+    }
+    root.off = (root.off + kCacheLineSize - 1) & ~(kCacheLineSize - 1);
+    nodes_ = reinterpret_cast<std::byte *>(pmemobj_direct(root));
+    const auto end = reinterpret_cast<uint64_t>(GetNode(node_capacity_));
+    value_bits = (1UL << (Log2(end) + 1)) - 1;
+  }
+
+  if ((value_bits & kReservedBits<Implementation>) != 0) {
+    throw std::runtime_error{"Values in this mode use bits reserved by this competitor."};
+  }
+}
+
+template <class Implementation>
+void
+PMwCASTarget<Implementation>::SetFixedTargetNum(  //
+    const size_t target_num)
+{
+  assert(target_num <= kMaxTargetNum);
+  constexpr auto kTable = MakeSpecializedTable(std::make_index_sequence<kMaxTargetNum + 1>{});
+  funcs_ = kTable[target_num];
+}
+
+template <class Implementation>
+auto
+PMwCASTarget<Implementation>::Execute(  //
+    const Operation &ops)               //
+    -> size_t
+{
+  return (this->*funcs_.execute)(ops, GetWorkerStats());
+}
+
+template <class Implementation>
+auto
+PMwCASTarget<Implementation>::ExecuteAll(  //
+    const std::vector<Operation> &queue)   //
+    -> size_t
+{
+  return (this->*funcs_.execute_all)(queue, GetWorkerStats());
 }
 
 /*##############################################################################
@@ -210,36 +681,721 @@ PMwCASTarget<PCAS>::Execute(  //
  *############################################################################*/
 
 template <class Implementation>
+template <size_t... kTargetNums>
+constexpr auto
+PMwCASTarget<Implementation>::MakeSpecializedTable(  //
+    std::index_sequence<kTargetNums...>)             //
+    -> std::array<SpecializedFuncs, sizeof...(kTargetNums)>
+{
+  return {SpecializedFuncs{&PMwCASTarget::template ExecuteOne<kTargetNums>,
+                           &PMwCASTarget::template ExecuteQueue<kTargetNums>,
+                           &PMwCASTarget::template Drain<kTargetNums>}...};
+}
+
+template <class Implementation>
+template <size_t kTargetNum>
+auto
+PMwCASTarget<Implementation>::ExecuteOne(  //
+    const Operation &ops,
+    WorkerStats &stats)                    //
+    -> size_t
+{
+  using Clock_t = std::chrono::steady_clock;
+
+  if (prefetch_distance_ > 0) {
+    Prefetch(ops, stats);
+  }
+  if (interleave_width_ > 1) return ExecuteInterleaved<kTargetNum>(ops, stats);
+
+  auto &num = (ops.IsPCAS()) ? stats.types.pcas_num : stats.types.pmwcas_num;
+  auto &ns = (ops.IsPCAS()) ? stats.types.pcas_ns : stats.types.pmwcas_ns;
+  auto &hist = (ops.IsPCAS()) ? stats.types.pcas_hist : stats.types.pmwcas_hist;
+  if (measure_tsc_latency_) {
+    const auto begin = TSCClock::Now();
+    Perform<kTargetNum>(ops, stats.cm);
+    stats.tsc_hist->Record(TSCClock::Now() - begin);
+  } else if (measure_type_latency_ || measure_contention_) {
+    const auto &begin = Clock_t::now();
+    Perform<kTargetNum>(ops, stats.cm);
+    const auto &end = Clock_t::now();
+    const size_t elapsed =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+    ns += elapsed;
+    hist.Record(elapsed);
+    if (measure_contention_) {
+      // attribute latency to the hottest target and the number of retries
+      const auto rank = ops.GetPosition(0) >> group_shift_;
+      const auto retry = stats.cm.GetFailureNum();
+      stats.hists[GetRankClass(rank) * kRetryClassNum + GetRetryClass(retry)].Record(elapsed);
+    }
+  } else {
+    Perform<kTargetNum>(ops, stats.cm);
+  }
+  if (stats.cm.GetFailureNum() > 0) {
+    ++stats.conflict_num;
+  }
+  stats.cm.Succeed();
+  ++num;
+  ++stats.exec_num;
+  if (value_mode_ == kPointerValue) {
+    stats.node_head += ops.GetTargetNum();  // nodes of failed attempts are rewritten
+  }
+
+  return 1;
+}
+
+template <class Implementation>
+template <size_t kTargetNum>
 auto
-PMwCASTarget<Implementation>::GetAddr(  //
-    const size_t pos)                   //
-    -> uint64_t *
+PMwCASTarget<Implementation>::ExecuteQueue(  //
+    const std::vector<Operation> &queue,
+    WorkerStats &stats)                      //
+    -> size_t
 {
-  return reinterpret_cast<uint64_t *>(root_addr_ + (pos << shift_num_));
+  size_t done_num = 0;
+  for (const auto &ops : queue) {
+    done_num += ExecuteOne<kTargetNum>(ops, stats);
+  }
+  return done_num;
+}
+
+template <class Implementation>
+template <size_t kTargetNum>
+auto
+PMwCASTarget<Implementation>::ComputeNewEncodedValues(  //
+    const Operation &ops,
+    const uint64_t *old_vals,
+    uint64_t *new_vals)                                 //
+    -> bool
+{
+  const auto n = (kTargetNum > 0) ? kTargetNum : ops.GetTargetNum();
+  uint64_t old_cnts[kMaxTargetNum];
+  uint64_t new_cnts[kMaxTargetNum];
+  for (size_t i = 0; i < n; ++i) {
+    old_cnts[i] = Decode(old_vals[i]);
+  }
+  if (!ops.template ComputeNewValues<kTargetNum>(old_cnts, new_cnts)) return false;
+
+  if (value_mode_ != kPointerValue) {
+    for (size_t i = 0; i < n; ++i) {
+      new_vals[i] = Encode(new_cnts[i]);
+    }
+    return true;
+  }
+
+  // write new values into the next nodes of the calling worker
+  auto &stats = *tls_stats_;
+  if (stats.node_head + n > stats.node_end) {
+    stats.node_head = node_cursor_.fetch_add(kNodeChunkSize, kMORelax);
+    stats.node_end = stats.node_head + kNodeChunkSize;
+    if (stats.node_end > node_capacity_) {
+      throw std::runtime_error{"Nodes for pointer values have been exhausted."};
+    }
+  }
+  for (size_t i = 0; i < n; ++i) {
+    auto *node = GetNode(stats.node_head + i);
+    *node = new_cnts[i];
+    pmem_flush(node, sizeof(uint64_t));
+    new_vals[i] = reinterpret_cast<uint64_t>(node);
+  }
+  pmem_drain();
+  return true;
+}
+
+template <class Implementation>
+auto
+PMwCASTarget<Implementation>::Encode(  //
+    const uint64_t cnt) const          //
+    -> uint64_t
+{
+  switch (value_mode_) {
+    case kRandomValue:
+      return EncodeRandomValue(cnt);
+    case kReservedValue:
+      return cnt | reserved_pattern_;
+    case kCounterValue:
+    case kPointerValue:  // nodes are written by workers
+    default:
+      return cnt;
+  }
+}
+
+template <class Implementation>
+auto
+PMwCASTarget<Implementation>::Decode(  //
+    const uint64_t val) const          //
+    -> uint64_t
+{
+  switch (value_mode_) {
+    case kPointerValue:
+      // zero is a null pointer for words that have never been written
+      return (val == 0) ? 0 : *reinterpret_cast<const uint64_t *>(val);
+    case kRandomValue:
+      return DecodeRandomValue(val);
+    case kReservedValue:
+      return val & ~reserved_pattern_;
+    case kCounterValue:
+    default:
+      return val;
+  }
+}
+
+template <class Implementation>
+template <size_t kTargetNum>
+void
+PMwCASTarget<Implementation>::Perform(  //
+    const Operation &ops,
+    ContentionManager &cm)
+{
+  if constexpr (std::is_same_v<Implementation, PMwCAS>) {
+    if (ops.IsPCAS()) {
+      PerformPCAS(ops, cm);
+    } else {
+      PerformPMwCAS<kTargetNum>(ops, cm);
+    }
+#ifndef PMWCAS_BENCH_DIRTY_VARIANT
+  } else if constexpr (std::is_same_v<Implementation, MicrosoftPMwCAS>) {
+    // microsoft/pmwcas has no single-word PCAS API, so PCAS operations are also
+    // performed with one-word descriptors
+    if (ops.IsPCAS()) {
+      PerformMicrosoftPMwCAS<1>(ops, cm);
+    } else {
+      PerformMicrosoftPMwCAS<kTargetNum>(ops, cm);
+    }
+  } else if constexpr (std::is_same_v<Implementation, PCAS>) {
+    PerformPCAS(ops, cm);
+  } else if constexpr (std::is_same_v<Implementation, LockMwCAS>) {
+    if (ops.IsPCAS()) {
+      PerformWithLocks<1>(ops);
+    } else {
+      PerformWithLocks<kTargetNum>(ops);
+    }
+  } else {
+    // a null competitor only decodes an operation to measure the harness
+    const auto n = (kTargetNum > 0 && !ops.IsPCAS()) ? kTargetNum : ops.GetTargetNum();
+    uint64_t *addrs[kMaxTargetNum];
+    uint64_t old_vals[kMaxTargetNum]{};
+    uint64_t new_vals[kMaxTargetNum];
+    for (size_t i = 0; i < n; ++i) {
+      addrs[i] = GetAddr(ops.GetPosition(i));
+    }
+    ops.ComputeNewValues(old_vals, new_vals);
+    asm volatile("" : : "r"(addrs), "r"(new_vals) : "memory");
+#endif
+  }
+}
+
+template <class Implementation>
+template <size_t kTargetNum>
+void
+PMwCASTarget<Implementation>::PerformPMwCAS(  //
+    const Operation &ops,
+    ContentionManager &cm)
+{
+  const auto n = (kTargetNum > 0) ? kTargetNum : ops.GetTargetNum();
+  uint64_t *addrs[kMaxTargetNum];
+  for (size_t i = 0; i < n; ++i) {
+    addrs[i] = GetAddr(ops.GetPosition(i));
+  }
+
+  while (!TryPMwCAS<kTargetNum>(ops, addrs)) {
+    cm.Backoff();
+  }
+}
+
+template <class Implementation>
+template <size_t kTargetNum>
+void
+PMwCASTarget<Implementation>::PerformMicrosoftPMwCAS(  //
+    const Operation &ops,
+    ContentionManager &cm)
+{
+  const auto n = (kTargetNum > 0) ? kTargetNum : ops.GetTargetNum();
+  uint64_t *addrs[kMaxTargetNum];
+  for (size_t i = 0; i < n; ++i) {
+    addrs[i] = GetAddr(ops.GetPosition(i));
+  }
+
+  auto &stats = *tls_stats_;
+  EnterEpoch(*desc_pool_, stats);
+  while (!TryMicrosoftPMwCAS<kTargetNum>(ops, addrs)) {
+    cm.Backoff();
+  }
+  LeaveEpoch(*desc_pool_, stats);
+}
+
+template <class Implementation>
+template <class Pool>
+void
+PMwCASTarget<Implementation>::EnterEpoch(  //
+    Pool &pool,
+    WorkerStats &stats)
+{
+  if (stats.in_epoch) return;
+
+  pool.GetEpoch()->Protect();
+  stats.in_epoch = true;
+  stats.epoch_countdown = epoch_scope_;
+}
+
+template <class Implementation>
+template <class Pool>
+void
+PMwCASTarget<Implementation>::LeaveEpoch(  //
+    Pool &pool,
+    WorkerStats &stats,
+    const bool force)
+{
+  auto *epoch = pool.GetEpoch();
+  if (measure_epoch_lag_ && !force) {
+    // descriptors retired after the reclaimable epoch are not reused yet
+    const size_t cur = epoch->GetCurrentEpoch();
+    const size_t safe = epoch->safe_to_reclaim_epoch.load(kMORelax);
+    const auto lag = (cur > safe) ? cur - safe : 0;
+    auto &sampled = stats.epoch_lag;
+    ++sampled.sample_num;
+    sampled.sum += lag;
+    sampled.max = std::max(sampled.max, lag);
+  }
+
+  if (!force && (epoch_scope_ == 0 || --stats.epoch_countdown > 0)) return;
+  epoch->Unprotect();
+  stats.in_epoch = false;
+}
+
+template <class Implementation>
+void
+PMwCASTarget<Implementation>::PerformPCAS(  //
+    const Operation &ops,
+    ContentionManager &cm)
+{
+  assert(ops.GetTargetNum() == 1);
+
+  auto *addr = GetAddr(ops.GetPosition(0));
+#ifdef PMWCAS_BENCH_EMULATE_PMEM
+  EmulateRead(1);
+#endif
+  auto old_val = ::dbgroup::pmem::atomic::PLoad(addr, kMORelax);
+  uint64_t new_val{};
+  while (ComputeNewValues<1>(ops, &old_val, &new_val)) {
+    ArmPreemption(&addr, &old_val, 1);
+    const auto done = ::dbgroup::pmem::atomic::PCAS(addr, old_val, new_val, kMORelax, kMORelax);
+    FirePreemption();
+    if (done) break;
+    cm.Backoff();  // continue until PCAS succeeds
+  }
+}
+
+template <class Implementation>
+template <size_t kTargetNum>
+auto
+PMwCASTarget<Implementation>::TryPMwCAS(  //
+    const Operation &ops,
+    uint64_t *const *addrs)               //
+    -> bool
+{
+  const auto n = (kTargetNum > 0) ? kTargetNum : ops.GetTargetNum();
+  uint64_t old_vals[kMaxTargetNum];
+  uint64_t new_vals[kMaxTargetNum];
+
+#ifdef PMWCAS_BENCH_EMULATE_PMEM
+  EmulateRead(n);
+#endif
+  for (size_t i = 0; i < n; ++i) {
+    old_vals[i] = ::dbgroup::pmem::atomic::PLoad(addrs[i], kMORelax);
+  }
+  if (!ComputeNewValues<kTargetNum>(ops, old_vals, new_vals)) return true;
+
+  ArmPreemption(addrs, old_vals, n);
+  auto *desc = desc_pool_->Get();
+  for (size_t i = 0; i < n; ++i) {
+    desc->Add(addrs[i], old_vals[i], new_vals[i], kMORelax);
+  }
+  const auto done = desc->PMwCAS();
+  FirePreemption();
+  return done;
+}
+
+template <class Implementation>
+template <size_t kTargetNum>
+auto
+PMwCASTarget<Implementation>::TryMicrosoftPMwCAS(  //
+    const Operation &ops,
+    uint64_t *const *addrs)                        //
+    -> bool
+{
+  using PMwCASField = ::pmwcas::MwcTargetField<uint64_t>;
+
+  const auto n = (kTargetNum > 0) ? kTargetNum : ops.GetTargetNum();
+  uint64_t old_vals[kMaxTargetNum];
+  uint64_t new_vals[kMaxTargetNum];
+
+#ifdef PMWCAS_BENCH_EMULATE_PMEM
+  EmulateRead(n);
+#endif
+  for (size_t i = 0; i < n; ++i) {
+    old_vals[i] = reinterpret_cast<PMwCASField *>(addrs[i])->GetValueProtected();
+  }
+  if (!ComputeNewValues<kTargetNum>(ops, old_vals, new_vals)) return true;
+
+  ArmPreemption(addrs, old_vals, n);
+  auto *desc = desc_pool_->AllocateDescriptor();
+  for (size_t i = 0; i < n; ++i) {
+    desc->AddEntry(addrs[i], old_vals[i], new_vals[i]);
+  }
+  const auto done = desc->MwCAS();
+  FirePreemption();
+  return done;
+}
+
+template <class Implementation>
+template <size_t kTargetNum>
+void
+PMwCASTarget<Implementation>::PerformWithLocks(  //
+    const Operation &ops)
+{
+  const auto n = (kTargetNum > 0) ? kTargetNum : ops.GetTargetNum();
+  uint64_t *addrs[kMaxTargetNum];
+  size_t stripes[kMaxTargetNum];
+  for (size_t i = 0; i < n; ++i) {
+    const auto pos = ops.GetPosition(i);
+    addrs[i] = GetAddr(pos);
+    stripes[i] = desc_pool_->GetStripe(pos);
+  }
+
+  // acquire stripes in ascending order to avoid deadlocks
+  std::sort(stripes, stripes + n);
+  const size_t lock_num = std::unique(stripes, stripes + n) - stripes;
+  bool contended = false;
+  for (size_t i = 0; i < lock_num; ++i) {
+    contended |= desc_pool_->Lock(stripes[i]);
+  }
+  if (contended) {
+    ++tls_stats_->conflict_num;  // waiting for a lock is a conflict of the blocking baseline
+  }
+
+  uint64_t old_vals[kMaxTargetNum];
+  uint64_t new_vals[kMaxTargetNum];
+#ifdef PMWCAS_BENCH_EMULATE_PMEM
+  EmulateRead(n);
+#endif
+  for (size_t i = 0; i < n; ++i) {
+    old_vals[i] = *addrs[i];
+  }
+  ArmPreemption(addrs, old_vals, n);
+  if (ComputeNewValues<kTargetNum>(ops, old_vals, new_vals)) {
+    for (size_t i = 0; i < n; ++i) {
+      *addrs[i] = new_vals[i];
+      pmem_flush(addrs[i], kWordSize);
+    }
+    pmem_drain();
+  }
+  FirePreemption();  // while holding locks
+
+  for (size_t i = lock_num; i > 0; --i) {
+    desc_pool_->Unlock(stripes[i - 1]);
+  }
+}
+
+template <class Implementation>
+void
+PMwCASTarget<Implementation>::ArmPreemption(  //
+    const uint64_t *const *addrs,
+    const uint64_t *old_vals,
+    const size_t n)
+{
+  if (preempt_interval_ == 0) return;
+
+  auto &stats = *tls_stats_;
+  if (--stats.preempt_countdown > 0) return;
+
+  stats.preempt_countdown = preempt_interval_;
+  GetPendingPreemption() = PendingPreemption{addrs, old_vals, n, preempt_sleep_us_};
+}
+
+template <class Implementation>
+void
+PMwCASTarget<Implementation>::FirePreemption()
+{
+  if (preempt_interval_ == 0) return;
+
+  auto &pending = GetPendingPreemption();
+  if (pending.n == 0) return;
+
+  pending.n = 0;
+  Preempt(preempt_sleep_us_);
+}
+
+template <class Implementation>
+auto
+PMwCASTarget<Implementation>::TryPCAS(  //
+    const Operation &ops)               //
+    -> bool
+{
+  assert(ops.GetTargetNum() == 1);
+
+  auto *addr = GetAddr(ops.GetPosition(0));
+#ifdef PMWCAS_BENCH_EMULATE_PMEM
+  EmulateRead(1);
+#endif
+  auto old_val = ::dbgroup::pmem::atomic::PLoad(addr, kMORelax);
+  uint64_t new_val{};
+  if (!ComputeNewValues<1>(ops, &old_val, &new_val)) return true;
+
+  ArmPreemption(&addr, &old_val, 1);
+  const auto done = ::dbgroup::pmem::atomic::PCAS(addr, old_val, new_val, kMORelax, kMORelax);
+  FirePreemption();
+  return done;
+}
+
+template <class Implementation>
+template <size_t kTargetNum>
+auto
+PMwCASTarget<Implementation>::TrySwap(  //
+    const Operation &ops)               //
+    -> bool
+{
+  const auto n = (kTargetNum > 0 && !ops.IsPCAS()) ? kTargetNum : ops.GetTargetNum();
+  uint64_t *addrs[kMaxTargetNum];
+  for (size_t i = 0; i < n; ++i) {
+    addrs[i] = GetAddr(ops.GetPosition(i));
+  }
+
+  if constexpr (std::is_same_v<Implementation, PMwCAS>) {
+    return (ops.IsPCAS()) ? TryPCAS(ops) : TryPMwCAS<kTargetNum>(ops, addrs);
+#ifndef PMWCAS_BENCH_DIRTY_VARIANT
+  } else if constexpr (std::is_same_v<Implementation, MicrosoftPMwCAS>) {
+    // the caller protects an epoch
+    return (ops.IsPCAS()) ? TryMicrosoftPMwCAS<1>(ops, addrs)
+                          : TryMicrosoftPMwCAS<kTargetNum>(ops, addrs);
+  } else if constexpr (std::is_same_v<Implementation, PCAS>) {
+    return TryPCAS(ops);
+  } else if constexpr (std::is_same_v<Implementation, LockMwCAS>) {
+    if (ops.IsPCAS()) {
+      PerformWithLocks<1>(ops);
+    } else {
+      PerformWithLocks<kTargetNum>(ops);
+    }
+    return true;
+  } else {
+    uint64_t old_vals[kMaxTargetNum]{};
+    uint64_t new_vals[kMaxTargetNum];
+    ops.ComputeNewValues(old_vals, new_vals);
+    asm volatile("" : : "r"(addrs), "r"(new_vals) : "memory");
+    return true;
+#endif
+  }
+}
+
+template <class Implementation>
+template <size_t kTargetNum>
+auto
+PMwCASTarget<Implementation>::ExecuteInterleaved(  //
+    const Operation &ops,
+    WorkerStats &stats)                          //
+    -> size_t
+{
+  auto &slots = stats.slots;
+  const auto width = slots.size();
+
+  // free the oldest slot, switching to other in-flight operations while it fails
+  size_t cnt = 0;
+  while (slots[stats.cursor].busy) {
+    if (Step<kTargetNum>(slots[stats.cursor], stats)) {
+      ++cnt;
+      break;
+    }
+    stats.cursor = (stats.cursor + 1) % width;
+  }
+
+  // issue a new operation by prefetching its targets
+  auto &slot = slots[stats.cursor];
+  slot.ops = ops;
+  slot.busy = true;
+  for (size_t i = 0; i < ops.GetTargetNum(); ++i) {
+    __builtin_prefetch(GetAddr(ops.GetPosition(i)), 1, 3);
+  }
+  stats.cursor = (stats.cursor + 1) % width;
+
+  if (++stats.issued_num == interleave_exec_num_) {
+    // complete the operations in flight within the measured region
+    cnt += Drain<kTargetNum>(stats);
+    stats.issued_num = 0;
+  }
+
+  return cnt;
+}
+
+template <class Implementation>
+template <size_t kTargetNum>
+auto
+PMwCASTarget<Implementation>::Step(  //
+    InFlight &slot,
+    WorkerStats &stats)              //
+    -> bool
+{
+  using Clock_t = std::chrono::steady_clock;
+
+  const auto is_pcas = slot.ops.IsPCAS();
+#ifndef PMWCAS_BENCH_DIRTY_VARIANT
+  if constexpr (std::is_same_v<Implementation, MicrosoftPMwCAS>) {
+    EnterEpoch(*desc_pool_, stats);  // do nothing if the worker is in an epoch
+  }
+#endif
+  bool done;
+  if (measure_type_latency_) {
+    const auto &begin = Clock_t::now();
+    done = TrySwap<kTargetNum>(slot.ops);
+    const auto &end = Clock_t::now();
+    slot.ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+  } else {
+    done = TrySwap<kTargetNum>(slot.ops);
+  }
+  if (!done) {
+    slot.failed = true;
+    stats.cm.Backoff();
+    return false;
+  }
+  stats.cm.Succeed();
+
+  if (slot.failed) {
+    ++stats.conflict_num;
+    slot.failed = false;
+  }
+  slot.busy = false;
+  if (measure_type_latency_) {
+    // the latency of an operation sums only the time of its attempts
+    auto &ns = (is_pcas) ? stats.types.pcas_ns : stats.types.pmwcas_ns;
+    auto &hist = (is_pcas) ? stats.types.pcas_hist : stats.types.pmwcas_hist;
+    ns += slot.ns;
+    hist.Record(slot.ns);
+    slot.ns = 0;
+  }
+  ++((is_pcas) ? stats.types.pcas_num : stats.types.pmwcas_num);
+  ++stats.exec_num;
+  if (value_mode_ == kPointerValue) {
+    stats.node_head += slot.ops.GetTargetNum();
+  }
+#ifndef PMWCAS_BENCH_DIRTY_VARIANT
+  if constexpr (std::is_same_v<Implementation, MicrosoftPMwCAS>) {
+    // an epoch scope counts completed operations as without interleaving
+    LeaveEpoch(*desc_pool_, stats);
+  }
+#endif
+  return true;
+}
+
+template <class Implementation>
+template <size_t kTargetNum>
+auto
+PMwCASTarget<Implementation>::Drain(  //
+    WorkerStats &stats)               //
+    -> size_t
+{
+  size_t cnt = 0;
+  for (auto &slot : stats.slots) {
+    if (!slot.busy) continue;
+    while (!Step<kTargetNum>(slot, stats)) {
+      // continue until the operation succeeds
+    }
+    ++cnt;
+  }
+  return cnt;
+}
+
+template <class Implementation>
+void
+PMwCASTarget<Implementation>::Prefetch(  //
+    const Operation &ops,
+    WorkerStats &stats)
+{
+  if (stats.prefetch_queue == nullptr) {
+    stats.prefetch_queue = &prefetch_queues_.at(ops.GetQueueID());
+    stats.prefetch_pos = 0;
+  }
+
+  // prefetch the targets of an upcoming operation in the same queue for write
+  const auto &queue = *stats.prefetch_queue;
+  const auto pos = stats.prefetch_pos++ + prefetch_distance_;
+  if (pos >= queue.size()) return;
+  const auto &upcoming = queue[pos];
+  for (size_t i = 0; i < upcoming.GetTargetNum(); ++i) {
+    __builtin_prefetch(GetAddr(upcoming.GetPosition(i)), 1, 3);
+  }
+}
+
+template <class Implementation>
+void
+PMwCASTarget<Implementation>::RegisterWorker()
+{
+  std::lock_guard guard{stats_mtx_};
+  stats_.emplace_back(std::make_unique<WorkerStats>());
+  tls_stats_ = stats_.back().get();
+  tls_stats_->cm = ContentionManager{contention_policy_, (id_ << 32UL) + stats_.size()};
+  tls_stats_->slots.resize(interleave_width_);
+  if (measure_contention_) {
+    tls_stats_->hists.resize(kRankClassNum * kRetryClassNum);
+  }
+  if (measure_tsc_latency_) {
+    tls_stats_->tsc_hist = std::make_unique<HDRHistogram>();
+  }
+  if (preempt_interval_ > 0) {
+    // give each worker a random phase so that workers are not preempted together
+    std::minstd_rand rand_engine{(id_ << 32UL) + stats_.size()};
+    tls_stats_->preempt_countdown = rand_engine() % preempt_interval_ + 1;
+  }
+  tls_target_id_ = id_;
 }
 
 template <class Implementation>
 void
 PMwCASTarget<Implementation>::Initialize(  //
     const std::string &pmem_dir_str,
-    const size_t array_cap)
+    const size_t array_cap,
+    const size_t segment_size)
 {
+  id_ = target_id_counter.fetch_add(1, kMORelax) + 1;
+  SetFixedTargetNum(0);
+
   // reset a target directory
   pmem_dir_str_ = GetPath(pmem_dir_str, kBenchPath);
   std::filesystem::remove_all(pmem_dir_str_);
   std::filesystem::create_directories(pmem_dir_str_);
 
-  // create a pool for persistent memory
-  const size_t array_size = block_size_ * (array_cap + 1);
-  const size_t pool_size = array_size + PMEMOBJ_MIN_POOL;
-  const auto &path = GetPath(pmem_dir_str_, kArrayName);
-  pop_ = pmemobj_create(path.c_str(), kArrayName, pool_size, kModeRW);
-  if (pop_ == nullptr) throw std::runtime_error{pmemobj_errormsg()};
+  // split an array into segments of power-of-two blocks
+  const auto block_num = (array_cap + words_per_group_ - 1) / words_per_group_;
+  auto seg_blocks = (segment_size == 0) ? block_num : segment_size / block_size_;
+  seg_shift_ = Log2(seg_blocks);
+  if ((1UL << seg_shift_) < seg_blocks) {
+    ++seg_shift_;  // round up to the power of two
+  }
+  seg_blocks = 1UL << seg_shift_;
+  const auto seg_num = (block_num + seg_blocks - 1) / seg_blocks;
 
+  // create a pool on persistent memory for each segment
   const auto bit_mask = block_size_ - 1;
-  auto &&root = pmemobj_root(pop_, array_size);
-  root.off = (root.off + bit_mask) & ~bit_mask;
-  root_addr_ = reinterpret_cast<std::byte *>(pmemobj_direct(root));
+  for (size_t i = 0; i < seg_num; ++i) {
+    const auto blocks = std::min(seg_blocks, block_num - i * seg_blocks);
+    const size_t array_size = block_size_ * (blocks + 1);
+    const size_t pool_size = array_size + PMEMOBJ_MIN_POOL;
+    const auto &name = std::string{kArrayName} + "_" + std::to_string(i);
+    const auto &path = GetPath(pmem_dir_str_, name);
+    auto *pop = pmemobj_create(path.c_str(), kArrayName, pool_size, kModeRW);
+    if (pop == nullptr) throw std::runtime_error{pmemobj_errormsg()};
+    pops_.emplace_back(pop);
+    array_paths_.emplace_back(path);
+
+    auto &&root = pmemobj_root(pop, array_size);
+    if (root.off == 0) {
+      throw std::runtime_error{"Failed to allocate an array (use smaller segments): "
+                               + std::string{pmemobj_errormsg()}};
+    }
+    root.off = (root.off + bit_mask) & ~bit_mask;
+    seg_addrs_.emplace_back(reinterpret_cast<std::byte *>(pmemobj_direct(root)));
+  }
+  if (seg_num == 1) {
+    root_addr_ = seg_addrs_.front();
+  }
 }
 
 /*##############################################################################
@@ -247,5 +1403,9 @@ PMwCASTarget<Implementation>::Initialize(  //
  *############################################################################*/
 
 template class PMwCASTarget<PMwCAS>;
+#ifndef PMWCAS_BENCH_DIRTY_VARIANT
 template class PMwCASTarget<MicrosoftPMwCAS>;
 template class PMwCASTarget<PCAS>;
+template class PMwCASTarget<LockMwCAS>;
+template class PMwCASTarget<NullPMwCAS>;
+#endif
@@ -0,0 +1,379 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "queue_target.hpp"
+
+// C++ standard libraries
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// system headers
+#include <sys/stat.h>
+
+// external system libraries
+#include <libpmem.h>
+#include <libpmemobj.h>
+
+// external libraries
+#include "pmem/atomic/atomic.hpp"
+#include "pmwcas.h"
+
+// local sources
+#include "common.hpp"
+#include "competitor.hpp"
+
+namespace
+{
+/*##############################################################################
+ * Local constants
+ *############################################################################*/
+
+/// @brief A directory name for queue benchmarks.
+constexpr char kQueueBenchPath[] = "pmwcas_queue_bench";
+
+/// @brief A layout name for the pool of PMwCAS descriptors.
+constexpr char kPMwCASName[] = "pmwcas";
+
+/// @brief A layout name for the pool of microsoft/pmwcas descriptors.
+constexpr char kMicrosoftPMwCASName[] = "microsoft_pmwcas";
+
+/// @brief A layout name for a queue.
+constexpr char kQueueName[] = "queue";
+
+/// @brief The size of a pool for microsoft/pmwcas descriptors (8GB).
+constexpr size_t kMicrosoftPoolSize = PMEMOBJ_MIN_POOL * 1024;
+
+/// @brief The number of partitions for microsoft/pmwcas descriptors.
+constexpr uint32_t kMicrosoftPartition = DBGROUP_MAX_THREAD_NUM;
+
+/// @brief The number of microsoft/pmwcas descriptors in each partition.
+constexpr uint32_t kMicrosoftDescPerPartition = 1024;
+
+/// @brief The number of words in each cache line.
+constexpr size_t kWordsPerLine = kCacheLineSize / kWordSize;
+
+/// @brief File permission for pmemobj_pool.
+constexpr auto kModeRW = S_IRUSR | S_IWUSR;  // NOLINT
+
+/// @brief An alias of std::memory_order_relaxed.
+constexpr std::memory_order kMORelax = std::memory_order_relaxed;
+
+}  // namespace
+
+/*##############################################################################
+ * Public constructors and destructors
+ *############################################################################*/
+
+template <class Implementation>
+QueueTarget<Implementation>::QueueTarget(  //
+    const std::string &pmem_dir_str,
+    const size_t capacity,
+    const size_t prefill_num)
+    : capacity_{capacity}, prefill_num_{prefill_num}
+{
+  // reset a target directory
+  pmem_dir_str_ = GetPath(pmem_dir_str, kQueueBenchPath);
+  std::filesystem::remove_all(pmem_dir_str_);
+  std::filesystem::create_directories(pmem_dir_str_);
+
+  // place a head, a tail, and slots in separate cache lines
+  const size_t queue_size = (capacity + 3 * kWordsPerLine) * kWordSize;
+  const auto &path = GetPath(pmem_dir_str_, kQueueName);
+  pop_ = pmemobj_create(path.c_str(), kQueueName, queue_size + PMEMOBJ_MIN_POOL, kModeRW);
+  if (pop_ == nullptr) throw std::runtime_error{pmemobj_errormsg()};
+
+  auto &&root = pmemobj_root(pop_, queue_size);
+  if (root.off == 0) throw std::runtime_error{pmemobj_errormsg()};
+  root.off = (root.off + kCacheLineSize - 1) & ~(kCacheLineSize - 1);
+  head_ = reinterpret_cast<uint64_t *>(pmemobj_direct(root));
+  tail_ = head_ + kWordsPerLine;
+  slots_ = tail_ + kWordsPerLine;
+
+  // enqueue initial elements so that consumers do not start with an empty queue
+  for (size_t i = 0; i < prefill_num; ++i) {
+    slots_[i] = i + 1;
+    prefill_sum_ += i + 1;
+  }
+  *tail_ = prefill_num;
+  pmem_persist(head_, queue_size - kCacheLineSize);
+
+  // prepare a pool of descriptors or locks
+  if constexpr (std::is_same_v<Implementation, PMwCAS>) {
+    const auto &pmwcas_path = GetPath(pmem_dir_str_, kPMwCASName);
+    desc_pool_ = std::make_unique<PMwCAS>(pmwcas_path, kPMwCASName);
+  } else if constexpr (std::is_same_v<Implementation, MicrosoftPMwCAS>) {
+    const auto &pmwcas_path = GetPath(pmem_dir_str_, kMicrosoftPMwCASName);
+    ::pmwcas::InitLibrary(
+        pmwcas::PMDKAllocator::Create(pmwcas_path.c_str(), kMicrosoftPMwCASName,
+                                      kMicrosoftPoolSize),
+        pmwcas::PMDKAllocator::Destroy,    //
+        pmwcas::LinuxEnvironment::Create,  //
+        pmwcas::LinuxEnvironment::Destroy);
+    desc_pool_ = std::make_unique<MicrosoftPMwCAS>(
+        kMicrosoftPartition * kMicrosoftDescPerPartition, kMicrosoftPartition);
+  } else {
+    desc_pool_ = std::make_unique<LockMwCAS>();
+  }
+}
+
+template <class Implementation>
+QueueTarget<Implementation>::~QueueTarget()
+{
+  desc_pool_ = nullptr;
+  pmemobj_close(pop_);
+  std::filesystem::remove_all(pmem_dir_str_);
+}
+
+/*##############################################################################
+ * Setup/Teardown for workers
+ *############################################################################*/
+
+template <class Implementation>
+void
+QueueTarget<Implementation>::SetUpForWorker()
+{
+  std::lock_guard guard{worker_mtx_};
+  const auto id = workers_.size() + 1;  // zero is used for initial elements
+
+  auto &worker = workers_.emplace_back(std::make_unique<Worker>());
+  worker->prefix = id << kSeqBits;
+  worker->cm = ContentionManager{contention_policy_, id};
+  tls_worker_ = worker.get();
+}
+
+/*##############################################################################
+ * Public APIs
+ *############################################################################*/
+
+template <class Implementation>
+auto
+QueueTarget<Implementation>::Execute(  //
+    const QueueOperation &ops)         //
+    -> size_t
+{
+  auto &w = *tls_worker_;
+  auto &stats = w.stats;
+
+  if constexpr (std::is_same_v<Implementation, MicrosoftPMwCAS>) {
+    desc_pool_->GetEpoch()->Protect();
+  }
+
+  size_t done_num = 1;
+  if (ops.is_enqueue) {
+    const auto val = w.prefix | (w.seq + 1);
+    if (Enqueue(w, val)) {
+      ++w.seq;
+      ++stats.enqueue_num;
+      stats.enqueued_sum += val;
+    } else {
+      ++stats.full_num;
+      done_num = 0;
+    }
+  } else {
+    uint64_t val{};
+    if (Dequeue(w, val)) {
+      ++stats.dequeue_num;
+      stats.dequeued_sum += val;
+    } else {
+      ++stats.empty_num;
+      done_num = 0;
+    }
+  }
+  w.cm.Succeed();
+
+  if constexpr (std::is_same_v<Implementation, MicrosoftPMwCAS>) {
+    desc_pool_->GetEpoch()->Unprotect();
+  }
+
+  return done_num;
+}
+
+template <class Implementation>
+auto
+QueueTarget<Implementation>::GetStats() const  //
+    -> QueueStats
+{
+  QueueStats total{};
+  for (const auto &worker : workers_) {
+    const auto &stats = worker->stats;
+    total.enqueue_num += stats.enqueue_num;
+    total.dequeue_num += stats.dequeue_num;
+    total.full_num += stats.full_num;
+    total.empty_num += stats.empty_num;
+    total.enqueued_sum += stats.enqueued_sum;
+    total.dequeued_sum += stats.dequeued_sum;
+  }
+  return total;
+}
+
+template <class Implementation>
+auto
+QueueTarget<Implementation>::Verify() const  //
+    -> bool
+{
+  // workers have finished, so scan the queue without atomic loads
+  const auto head = *head_;
+  const auto tail = *tail_;
+  if (head > tail || tail - head > capacity_) return false;
+
+  uint64_t sum = 0;
+  for (size_t i = 0; i < capacity_; ++i) {
+    // only slots within the distance of the size from the head are occupied
+    const auto dist = (i - head) & (capacity_ - 1);
+    if ((dist < tail - head) != (slots_[i] != kEmpty)) return false;
+    sum += slots_[i];
+  }
+
+  const auto &stats = GetStats();
+  return head == stats.dequeue_num && tail == prefill_num_ + stats.enqueue_num
+         && sum == prefill_sum_ + stats.enqueued_sum - stats.dequeued_sum;
+}
+
+/*##############################################################################
+ * Internal utilities
+ *############################################################################*/
+
+template <class Implementation>
+auto
+QueueTarget<Implementation>::Enqueue(  //
+    Worker &w,
+    const uint64_t val)                //
+    -> bool
+{
+  while (true) {
+    const auto tail = Read(tail_);
+    auto *slot = GetSlot(tail);
+    if (Read(slot) != kEmpty) {
+      // the slot is occupied by the oldest element or the tail has moved
+      if (tail - Read(head_) >= capacity_) return false;
+    } else if (TrySwap(tail_, tail, tail + 1, slot, kEmpty, val)) {
+      return true;
+    }
+    w.cm.Backoff();
+  }
+}
+
+template <class Implementation>
+auto
+QueueTarget<Implementation>::Dequeue(  //
+    Worker &w,
+    uint64_t &val)                     //
+    -> bool
+{
+  while (true) {
+    const auto head = Read(head_);
+    auto *slot = GetSlot(head);
+    val = Read(slot);
+    if (val == kEmpty) {
+      // the queue is empty or the head has moved
+      if (Read(tail_) <= head) return false;
+    } else if (TrySwap(head_, head, head + 1, slot, val, kEmpty)) {
+      return true;
+    }
+    w.cm.Backoff();
+  }
+}
+
+template <class Implementation>
+auto
+QueueTarget<Implementation>::Read(  //
+    uint64_t *addr)                 //
+    -> uint64_t
+{
+  if constexpr (std::is_same_v<Implementation, PMwCAS>) {
+    return ::dbgroup::pmem::atomic::PLoad(addr, kMORelax);
+  } else if constexpr (std::is_same_v<Implementation, MicrosoftPMwCAS>) {
+    using PMwCASField = ::pmwcas::MwcTargetField<uint64_t>;
+    return reinterpret_cast<PMwCASField *>(addr)->GetValueProtected();
+  } else {
+    return reinterpret_cast<std::atomic_uint64_t *>(addr)->load(kMORelax);
+  }
+}
+
+template <class Implementation>
+auto
+QueueTarget<Implementation>::TrySwap(  //
+    uint64_t *addr_1,
+    const uint64_t old_1,
+    const uint64_t new_1,
+    uint64_t *addr_2,
+    const uint64_t old_2,
+    const uint64_t new_2)              //
+    -> bool
+{
+  if constexpr (std::is_same_v<Implementation, PMwCAS>) {
+    auto *desc = desc_pool_->Get();
+    desc->Add(addr_1, old_1, new_1, kMORelax);
+    desc->Add(addr_2, old_2, new_2, kMORelax);
+    return desc->PMwCAS();
+  } else if constexpr (std::is_same_v<Implementation, MicrosoftPMwCAS>) {
+    auto *desc = desc_pool_->AllocateDescriptor();
+    desc->AddEntry(addr_1, old_1, new_1);
+    desc->AddEntry(addr_2, old_2, new_2);
+    return desc->MwCAS();
+  } else {
+    // acquire stripes in ascending order to avoid deadlocks
+    auto stripe_1 = desc_pool_->GetStripe(GetPosition(addr_1));
+    auto stripe_2 = desc_pool_->GetStripe(GetPosition(addr_2));
+    if (stripe_1 > stripe_2) std::swap(stripe_1, stripe_2);
+    desc_pool_->Lock(stripe_1);
+    if (stripe_2 != stripe_1) desc_pool_->Lock(stripe_2);
+
+    auto *word_1 = reinterpret_cast<std::atomic_uint64_t *>(addr_1);
+    auto *word_2 = reinterpret_cast<std::atomic_uint64_t *>(addr_2);
+    const auto success = word_1->load(kMORelax) == old_1 && word_2->load(kMORelax) == old_2;
+    if (success) {
+      word_1->store(new_1, kMORelax);
+      word_2->store(new_2, kMORelax);
+      pmem_flush(addr_1, kWordSize);
+      pmem_flush(addr_2, kWordSize);
+      pmem_drain();
+    }
+
+    if (stripe_2 != stripe_1) desc_pool_->Unlock(stripe_2);
+    desc_pool_->Unlock(stripe_1);
+    return success;
+  }
+}
+
+template <class Implementation>
+auto
+QueueTarget<Implementation>::GetPosition(  //
+    const uint64_t *addr) const            //
+    -> size_t
+{
+  // the head and tail precede the slots
+  if (addr == head_) return 0;
+  if (addr == tail_) return 1;
+  return static_cast<size_t>(addr - slots_) + 2;
+}
+
+/*##############################################################################
+ * Explicit instantiation definitions
+ *############################################################################*/
+
+template class QueueTarget<PMwCAS>;
+template class QueueTarget<MicrosoftPMwCAS>;
+template class QueueTarget<LockMwCAS>;
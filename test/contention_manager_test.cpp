@@ -0,0 +1,122 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "contention_manager.hpp"
+
+// C++ standard libraries
+#include <cstddef>
+
+// external libraries
+#include "gtest/gtest.h"
+
+class ContentionManagerFixture : public ::testing::Test
+{
+ protected:
+  /*############################################################################
+   * Constants
+   *##########################################################################*/
+
+  static constexpr size_t kRepeatNum = 100;
+
+  static constexpr size_t kRandomSeed = 0;
+
+  static constexpr size_t kMaxWait = 1UL << ContentionManager::kMaxWindowShift;
+
+  /*############################################################################
+   * Setup/Teardown
+   *##########################################################################*/
+
+  void
+  SetUp() override
+  {
+  }
+
+  void
+  TearDown() override
+  {
+  }
+};
+
+/*------------------------------------------------------------------------------
+ * Test definitions
+ *----------------------------------------------------------------------------*/
+
+TEST_F(ContentionManagerFixture, BackoffWithoutPolicyNeverWait)
+{
+  ContentionManager cm{kNoBackoff, kRandomSeed};
+  for (size_t i = 0; i < kRepeatNum; ++i) {
+    EXPECT_EQ(cm.Backoff(), 0);
+  }
+}
+
+TEST_F(ContentionManagerFixture, ExponentialBackoffDoubleWindowUntilSuccess)
+{
+  ContentionManager cm{kExponentialBackoff, kRandomSeed};
+  EXPECT_EQ(cm.Backoff(), 2);
+  EXPECT_EQ(cm.Backoff(), 4);
+  EXPECT_EQ(cm.Backoff(), 8);
+  for (size_t i = 0; i < kRepeatNum; ++i) {
+    EXPECT_LE(cm.Backoff(), kMaxWait);
+  }
+
+  cm.Succeed();
+  EXPECT_EQ(cm.Backoff(), 2);
+}
+
+TEST_F(ContentionManagerFixture, RandomizedBackoffWaitWithinWindow)
+{
+  ContentionManager cm{kRandomizedBackoff, kRandomSeed};
+  size_t window = 2;
+  for (size_t i = 0; i < kRepeatNum; ++i) {
+    EXPECT_LT(cm.Backoff(), window);
+    if (window < kMaxWait) window <<= 1UL;
+  }
+}
+
+TEST_F(ContentionManagerFixture, AdaptiveBackoffWaitOnlyUnderHighFailureRate)
+{
+  ContentionManager cm{kAdaptiveBackoff, kRandomSeed};
+
+  // a rare failure does not cause waiting
+  EXPECT_EQ(cm.Backoff(), 0);
+  cm.Succeed();
+  EXPECT_LE(cm.GetFailureRate(), ContentionManager::kAdaptiveThreshold);
+
+  // continuous failures raise the failure rate
+  for (size_t i = 0; i < kRepeatNum; ++i) {
+    EXPECT_LE(cm.Backoff(), kMaxWait);
+  }
+  EXPECT_GT(cm.GetFailureRate(), ContentionManager::kAdaptiveThreshold);
+
+  // successes lower the failure rate again
+  for (size_t i = 0; i < kRepeatNum; ++i) {
+    cm.Succeed();
+  }
+  EXPECT_LE(cm.GetFailureRate(), ContentionManager::kAdaptiveThreshold);
+}
+
+TEST_F(ContentionManagerFixture, GetFailureNumCountFailuresUntilSuccess)
+{
+  ContentionManager cm{kNoBackoff, kRandomSeed};
+  for (size_t i = 0; i < kRepeatNum; ++i) {
+    cm.Backoff();
+  }
+  EXPECT_EQ(cm.GetFailureNum(), kRepeatNum);
+
+  cm.Succeed();
+  EXPECT_EQ(cm.GetFailureNum(), 0);
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "counter_rng.hpp"
+
+// C++ standard libraries
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+// external libraries
+#include "gtest/gtest.h"
+
+class CounterRNGFixture : public ::testing::Test
+{
+ protected:
+  /*############################################################################
+   * Constants
+   *##########################################################################*/
+
+  static constexpr uint64_t kRandomSeed = 42;
+
+  static constexpr size_t kN = 1000;
+
+  /*############################################################################
+   * Setup/Teardown
+   *##########################################################################*/
+
+  void
+  SetUp() override
+  {
+  }
+
+  void
+  TearDown() override
+  {
+  }
+};
+
+/*------------------------------------------------------------------------------
+ * Test definitions
+ *----------------------------------------------------------------------------*/
+
+TEST_F(CounterRNGFixture, SameSeedAndStreamGenerateSameValues)
+{
+  CounterRNG rng_1{kRandomSeed, 1};
+  CounterRNG rng_2{kRandomSeed, 1};
+  for (size_t i = 0; i < kN; ++i) {
+    EXPECT_EQ(rng_1(), rng_2());
+  }
+}
+
+TEST_F(CounterRNGFixture, DifferentStreamsGenerateDifferentValues)
+{
+  CounterRNG rng_1{kRandomSeed, 0};
+  CounterRNG rng_2{kRandomSeed, 1};
+  auto split_1 = rng_1.Split(0);
+  auto split_2 = rng_1.Split(1);
+
+  size_t same_num = 0;
+  for (size_t i = 0; i < kN; ++i) {
+    const auto val = rng_1();
+    if (val == rng_2()) ++same_num;
+    if (val == split_1()) ++same_num;
+    if (split_1() == split_2()) ++same_num;
+  }
+  EXPECT_EQ(same_num, 0);
+}
+
+TEST_F(CounterRNGFixture, DistributionsReceiveValuesInRange)
+{
+  constexpr size_t kMax = 9;
+
+  CounterRNG rng{kRandomSeed};
+  std::uniform_int_distribution<size_t> dist{0, kMax};
+  size_t hist[kMax + 1]{};
+  for (size_t i = 0; i < kN * (kMax + 1); ++i) {
+    const auto val = dist(rng);
+    ASSERT_LE(val, kMax);
+    ++hist[val];
+  }
+  for (const auto cnt : hist) {
+    EXPECT_GT(cnt, kN / 2);
+    EXPECT_LT(cnt, kN * 2);
+  }
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "latency_histogram.hpp"
+
+// C++ standard libraries
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// external libraries
+#include "gtest/gtest.h"
+
+class LatencyHistogramFixture : public ::testing::Test
+{
+ protected:
+  /*############################################################################
+   * Constants
+   *##########################################################################*/
+
+  static constexpr uint64_t kMaxVal = 1UL << 20UL;
+
+  static constexpr double kMaxError = 1.0 / LatencyHistogram::kSubBucketNum;
+
+  static constexpr double kHDRMaxError = 1.0 / HDRHistogram::kSubBucketNum;
+
+  static constexpr size_t kThreadNum = 8;
+
+  /*############################################################################
+   * Setup/Teardown
+   *##########################################################################*/
+
+  void
+  SetUp() override
+  {
+  }
+
+  void
+  TearDown() override
+  {
+  }
+};
+
+/*------------------------------------------------------------------------------
+ * Test definitions
+ *----------------------------------------------------------------------------*/
+
+TEST_F(LatencyHistogramFixture, GetIndexKeepValuesInOrderWithinError)
+{
+  size_t prev = 0;
+  for (uint64_t val = 0; val < kMaxVal; ++val) {
+    const auto index = LatencyHistogram::GetIndex(val);
+    EXPECT_GE(index, prev);
+    EXPECT_LT(index, LatencyHistogram::kBucketNum);
+    const auto upper = LatencyHistogram::GetUpperBound(index);
+    EXPECT_GE(upper, val);
+    EXPECT_LE(upper - val, val * kMaxError);
+    prev = index;
+  }
+}
+
+TEST_F(LatencyHistogramFixture, GetIndexWithHugeValuesUseLastBucket)
+{
+  EXPECT_EQ(LatencyHistogram::GetIndex(~0UL), LatencyHistogram::kBucketNum - 1);
+}
+
+TEST_F(LatencyHistogramFixture, GetPercentileReturnBoundsOfRecordedValues)
+{
+  LatencyHistogram hist{};
+  for (uint64_t val = 1; val <= 100; ++val) {
+    hist.Record(val);
+  }
+  EXPECT_EQ(hist.GetCount(), 100);
+  EXPECT_EQ(hist.GetPercentile(0.01), 1);
+  EXPECT_EQ(hist.GetPercentile(0.05), 5);
+
+  const auto p50 = hist.GetPercentile(0.5);
+  EXPECT_GE(p50, 50);
+  EXPECT_LE(p50, 50 * (1 + kMaxError));
+  const auto p100 = hist.GetPercentile(1.0);
+  EXPECT_GE(p100, 100);
+  EXPECT_LE(p100, 100 * (1 + kMaxError));
+}
+
+TEST_F(LatencyHistogramFixture, MergeAddCountsOfBothHistograms)
+{
+  LatencyHistogram low{};
+  LatencyHistogram high{};
+  for (size_t i = 0; i < 10; ++i) {
+    low.Record(1);
+    high.Record(1000);
+  }
+
+  low.Merge(high);
+  EXPECT_EQ(low.GetCount(), 20);
+  EXPECT_EQ(low.GetPercentile(0.5), 1);
+  EXPECT_GE(low.GetPercentile(0.51), 1000);
+}
+
+TEST_F(LatencyHistogramFixture, HDRHistogramKeepValuesWithinSmallError)
+{
+  for (uint64_t val = 0; val < kMaxVal; ++val) {
+    const auto upper = HDRHistogram::GetUpperBound(HDRHistogram::GetIndex(val));
+    EXPECT_GE(upper, val);
+    EXPECT_LE(upper - val, val * kHDRMaxError);
+  }
+}
+
+TEST_F(LatencyHistogramFixture, MergeAtomicallyFromMultipleThreadsKeepAllCounts)
+{
+  constexpr size_t kRecNum = 100000;
+
+  auto total = std::make_unique<HDRHistogram>();
+  std::vector<std::thread> threads{};
+  for (size_t i = 0; i < kThreadNum; ++i) {
+    threads.emplace_back([&total, i] {
+      auto hist = std::make_unique<HDRHistogram>();
+      for (size_t j = 0; j < kRecNum; ++j) {
+        hist->Record(i * kRecNum + j);
+      }
+      total->MergeAtomically(*hist);
+    });
+  }
+  for (auto &&t : threads) {
+    t.join();
+  }
+
+  const auto max_val = kThreadNum * kRecNum - 1;
+  EXPECT_EQ(total->GetCount(), kThreadNum * kRecNum);
+  EXPECT_GE(total->GetPercentile(0.99999), max_val * (1 - kHDRMaxError));
+  EXPECT_LE(total->GetPercentile(1.0), max_val * (1 + kHDRMaxError));
+}
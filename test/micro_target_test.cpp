@@ -0,0 +1,138 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "micro_target.hpp"
+
+// C++ standard libraries
+#include <cstddef>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// external libraries
+#include "gtest/gtest.h"
+
+// macros for modifying input strings
+#define DBGROUP_ADD_QUOTES_INNER(x) #x                     // NOLINT
+#define DBGROUP_ADD_QUOTES(x) DBGROUP_ADD_QUOTES_INNER(x)  // NOLINT
+
+/*##############################################################################
+ * Global contants
+ *############################################################################*/
+
+constexpr size_t kTestThreadNum = DBGROUP_TEST_THREAD_NUM;
+
+constexpr std::string_view kTmpPMEMPath = DBGROUP_ADD_QUOTES(DBGROUP_TEST_TMP_PMEM_PATH);
+
+constexpr size_t kExecNum = 1E4;
+
+const std::string_view use_name = std::getenv("USER");
+
+/*##############################################################################
+ * Fixture definitions
+ *############################################################################*/
+
+class MicroTargetFixture : public ::testing::Test
+{
+ protected:
+  /*############################################################################
+   * Setup/Teardown
+   *##########################################################################*/
+
+  void
+  SetUp() override
+  {
+    if (kTmpPMEMPath.empty() || !std::filesystem::exists(kTmpPMEMPath)) {
+      std::cerr << "WARN: The correct path to persistent memory is not set." << std::endl;
+      GTEST_SKIP();
+    }
+  }
+
+  void
+  TearDown() override
+  {
+  }
+
+  /*############################################################################
+   * Utilities
+   *##########################################################################*/
+
+  void
+  RunPrimitive(  //
+      const Primitive primitive,
+      const size_t target_num)
+  {
+    std::filesystem::path pool_path{kTmpPMEMPath};
+    pool_path /= use_name;
+
+    for (const auto sharing : {kNoSharing, kFalseSharing, kTrueSharing}) {
+      for (const auto dirty_lines : {false, true}) {
+        MicroTarget target{pool_path,  primitive,   sharing,
+                           target_num, dirty_lines, kTestThreadNum};
+
+        std::vector<std::thread> threads{};
+        for (size_t i = 0; i < kTestThreadNum; ++i) {
+          threads.emplace_back([&]() {
+            target.SetUpForWorker();
+            for (size_t j = 0; j < kExecNum; ++j) {
+              EXPECT_EQ(target.Execute(MicroOperation{}), 1);
+            }
+            target.TearDownForWorker();
+          });
+        }
+        for (auto &&t : threads) t.join();
+      }
+    }
+  }
+};
+
+/*------------------------------------------------------------------------------
+ * Test definitions
+ *----------------------------------------------------------------------------*/
+
+TEST_F(MicroTargetFixture, PLoadWithAllPlacements)
+{  //
+  RunPrimitive(kPLoad, 1);
+}
+
+TEST_F(MicroTargetFixture, PCASWithAllPlacements)
+{  //
+  RunPrimitive(kPCAS, 1);
+}
+
+TEST_F(MicroTargetFixture, PMwCASDescriptorWithAllPlacements)
+{  //
+  RunPrimitive(kPMwCASDesc, kMaxTargetNum);
+}
+
+TEST_F(MicroTargetFixture, MicrosoftDescriptorWithAllPlacements)
+{  //
+  RunPrimitive(kMicrosoftDesc, kMaxTargetNum);
+}
+
+TEST_F(MicroTargetFixture, EpochWithAllPlacements)
+{  //
+  RunPrimitive(kEpoch, 1);
+}
+
+TEST_F(MicroTargetFixture, FlushFenceWithAllPlacements)
+{  //
+  RunPrimitive(kFlushFence, 1);
+}
@@ -19,6 +19,8 @@
 
 // C++ standard libraries
 #include <cstddef>
+#include <thread>
+#include <vector>
 
 // external libraries
 #include "gtest/gtest.h"
@@ -59,16 +61,210 @@ TEST_F(OperationEngineFixture, GenerateCreateSortedTargetPositions)
   constexpr auto kRandomSeed = 0;
   constexpr auto kN = 1000;
 
-  OperationEngine ops_engine{kTargetNum, kArrayCapacity, kSkewParam, kRandomSeed};
+  OperationEngine ops_engine{kTargetNum, kArrayCapacity, kSkewParam};
 
   const auto &operations = ops_engine.Generate(kN, kRandomSeed);
   for (const auto &ops : operations) {
-    const auto &positions = ops.GetPositions();
-    auto prev_pos = positions.at(0);
+    EXPECT_EQ(ops.GetTargetNum(), kTargetNum);
+    auto prev_pos = ops.GetPosition(0);
     for (size_t i = 1; i < kTargetNum; ++i) {
-      const auto cur_pos = positions.at(i);
+      const auto cur_pos = ops.GetPosition(i);
       EXPECT_LT(prev_pos, cur_pos);
       prev_pos = cur_pos;
     }
   }
 }
+
+TEST_F(OperationEngineFixture, GenerateWithTransferCreateTwoOrMoreTargets)
+{
+  constexpr auto kSkewParam = 0;
+  constexpr auto kRandomSeed = 0;
+  constexpr auto kN = 1000;
+  constexpr size_t kTransferTargetNum = 4;
+
+  OperationEngine ops_engine{kTransferTargetNum, kArrayCapacity, kSkewParam, kTransfer};
+
+  const auto &operations = ops_engine.Generate(kN, kRandomSeed);
+  for (const auto &ops : operations) {
+    const auto target_num = ops.GetTargetNum();
+    EXPECT_GE(target_num, 2);
+    EXPECT_LE(target_num, kTransferTargetNum);
+  }
+}
+
+TEST_F(OperationEngineFixture, GenerateWithGroupsCreateCoLocatedTargets)
+{
+  constexpr auto kSkewParam = 0;
+  constexpr auto kRandomSeed = 0;
+  constexpr auto kN = 1000;
+  constexpr size_t kWordsPerGroup = 4;
+
+  OperationEngine ops_engine{kTargetNum, kArrayCapacity, kSkewParam, kIncrement, kWordsPerGroup};
+
+  const auto &operations = ops_engine.Generate(kN, kRandomSeed);
+  for (const auto &ops : operations) {
+    EXPECT_EQ(ops.GetTargetNum(), kTargetNum);
+    const auto group = ops.GetPosition(0) / kWordsPerGroup;
+    for (size_t i = 0; i < kTargetNum; ++i) {
+      EXPECT_EQ(ops.GetPosition(i) / kWordsPerGroup, group);
+    }
+  }
+}
+
+TEST_F(OperationEngineFixture, GenerateWithPCASRatioMixSingleWordOperations)
+{
+  constexpr auto kSkewParam = 0;
+  constexpr auto kRandomSeed = 0;
+  constexpr auto kN = 1000;
+  constexpr size_t kWordsPerGroup = 1;
+  constexpr auto kPCASRatio = 0.5;
+
+  OperationEngine ops_engine{kTargetNum, kArrayCapacity, kSkewParam,
+                             kIncrement, kWordsPerGroup, kPCASRatio};
+
+  size_t pcas_num = 0;
+  const auto &operations = ops_engine.Generate(kN, kRandomSeed);
+  for (const auto &ops : operations) {
+    const auto target_num = ops.GetTargetNum();
+    if (ops.IsPCAS()) {
+      EXPECT_EQ(target_num, 1);
+      ++pcas_num;
+    } else {
+      EXPECT_EQ(target_num, kTargetNum);
+    }
+  }
+  EXPECT_GT(pcas_num, 0);
+  EXPECT_LT(pcas_num, kN);
+}
+
+TEST_F(OperationEngineFixture, PrepareSetQueueIDsOfWorkers)
+{
+  constexpr auto kSkewParam = 0;
+  constexpr auto kRandomSeed = 0;
+  constexpr size_t kN = 1000;
+  constexpr size_t kWorkerNum = 4;
+  constexpr size_t kThreadNum = 2;
+
+  OperationEngine ops_engine{kTargetNum, kArrayCapacity, kSkewParam};
+  ops_engine.Prepare(kWorkerNum, kN, kRandomSeed, kThreadNum);
+
+  // a target can look ahead in copies of the queues that workers will receive
+  const auto &copies = ops_engine.GetPreparedQueues();
+  ASSERT_EQ(copies.size(), kWorkerNum);
+  for (size_t id = 0; id < kWorkerNum; ++id) {
+    const auto &operations = ops_engine.Generate(kN, kRandomSeed + id);
+    ASSERT_EQ(copies[id].size(), kN);
+    for (size_t i = 0; i < kN; ++i) {
+      EXPECT_EQ(operations[i].GetQueueID(), id);
+      EXPECT_EQ(copies[id][i].GetPosition(0), operations[i].GetPosition(0));
+    }
+  }
+}
+
+TEST_F(OperationEngineFixture, GenerateWithConflictControlSeparatePartitions)
+{
+  constexpr auto kSkewParam = 0;
+  constexpr auto kRandomSeed = 0;
+  constexpr size_t kN = 1000;
+  constexpr size_t kThreadNum = 4;
+  constexpr auto kConflictRatio = 0.25;
+  constexpr size_t kRegionSize = 16;
+  constexpr size_t kPartitionSize = (kArrayCapacity - kRegionSize) / kThreadNum;
+
+  OperationEngine ops_engine{kTargetNum, kArrayCapacity, kSkewParam};
+  ops_engine.SetConflictControl(kThreadNum, kConflictRatio, kRegionSize);
+
+  for (size_t id = 0; id < kThreadNum; ++id) {
+    const auto head = kRegionSize + id * kPartitionSize;
+    size_t conflict_num = 0;
+    const auto &operations = ops_engine.Generate(kN, kRandomSeed + id);
+    for (const auto &ops : operations) {
+      ASSERT_EQ(ops.GetTargetNum(), kTargetNum);
+      const auto in_region = ops.GetPosition(0) < kRegionSize;
+      if (in_region) ++conflict_num;
+      for (size_t i = 0; i < kTargetNum; ++i) {
+        const auto pos = ops.GetPosition(i);
+        if (in_region) {
+          EXPECT_LT(pos, kRegionSize);
+        } else {
+          EXPECT_GE(pos, head);
+          EXPECT_LT(pos, head + kPartitionSize);
+        }
+      }
+    }
+    EXPECT_GT(conflict_num, 0);
+    EXPECT_LT(conflict_num, kN / 2);
+  }
+}
+
+TEST_F(OperationEngineFixture, PrepareCreateSameOperationsWithAnyThreadNum)
+{
+  constexpr auto kSkewParam = 0;
+  constexpr auto kRandomSeed = 0;
+  constexpr size_t kN = 10000;
+  constexpr size_t kWorkerNum = 4;
+  constexpr size_t kGenThreadNum = 3;
+
+  OperationEngine serial_engine{kTargetNum, kArrayCapacity, kSkewParam};
+  OperationEngine parallel_engine{kTargetNum, kArrayCapacity, kSkewParam};
+  OperationEngine ops_engine{kTargetNum, kArrayCapacity, kSkewParam};
+  serial_engine.Prepare(kWorkerNum, kN, kRandomSeed, 1);
+  parallel_engine.Prepare(kWorkerNum, kN, kRandomSeed, kGenThreadNum);
+
+  for (size_t w = 0; w < kWorkerNum; ++w) {
+    const auto &serial = serial_engine.Generate(kN, kRandomSeed + w);
+    const auto &parallel = parallel_engine.Generate(kN, kRandomSeed + w);
+    const auto &expected = ops_engine.Generate(kN, kRandomSeed + w);
+    ASSERT_EQ(serial.size(), kN);
+    ASSERT_EQ(parallel.size(), kN);
+    for (size_t i = 0; i < kN; ++i) {
+      ASSERT_EQ(serial[i].GetTargetNum(), kTargetNum);
+      ASSERT_EQ(parallel[i].GetTargetNum(), kTargetNum);
+      for (size_t j = 0; j < kTargetNum; ++j) {
+        EXPECT_EQ(serial[i].GetPosition(j), expected[i].GetPosition(j));
+        EXPECT_EQ(parallel[i].GetPosition(j), expected[i].GetPosition(j));
+      }
+    }
+  }
+}
+
+TEST_F(OperationEngineFixture, GenerateWithWorkerSeedsHandOverPreparedQueues)
+{
+  constexpr auto kSkewParam = 0;
+  constexpr size_t kRandomSeed = 10;
+  constexpr size_t kN = 10000;
+  constexpr size_t kWorkerNum = 4;
+  constexpr size_t kGenThreadNum = 2;
+
+  OperationEngine ops_engine{kTargetNum, kArrayCapacity, kSkewParam};
+  OperationEngine expected_engine{kTargetNum, kArrayCapacity, kSkewParam};
+  ops_engine.Prepare(kWorkerNum, kN, kRandomSeed, kGenThreadNum);
+  EXPECT_FALSE(ops_engine.IsPrepared(kN, kRandomSeed - 1));
+  EXPECT_FALSE(ops_engine.IsPrepared(kN, kRandomSeed + kWorkerNum));
+  EXPECT_FALSE(ops_engine.IsPrepared(kN + 1, kRandomSeed));
+
+  // workers of a benchmarker request their queues with `seed + i` concurrently
+  std::vector<std::vector<Operation>> queues(kWorkerNum);
+  std::vector<std::thread> threads{};
+  for (size_t w = 0; w < kWorkerNum; ++w) {
+    ASSERT_TRUE(ops_engine.IsPrepared(kN, kRandomSeed + w));
+    threads.emplace_back([&, w]() { queues[w] = ops_engine.Generate(kN, kRandomSeed + w); });
+  }
+  for (auto &&t : threads) t.join();
+
+  for (size_t w = 0; w < kWorkerNum; ++w) {
+    EXPECT_FALSE(ops_engine.IsPrepared(kN, kRandomSeed + w));
+    const auto &expected = expected_engine.Generate(kN, kRandomSeed + w);
+    ASSERT_EQ(queues[w].size(), kN);
+    for (size_t i = 0; i < kN; ++i) {
+      for (size_t j = 0; j < kTargetNum; ++j) {
+        EXPECT_EQ(queues[w][i].GetPosition(j), expected[i].GetPosition(j));
+      }
+    }
+
+    // a queue is handed over only once, and later calls generate it again
+    const auto &regenerated = ops_engine.Generate(kN, kRandomSeed + w);
+    ASSERT_EQ(regenerated.size(), kN);
+    EXPECT_EQ(regenerated[kN - 1].GetPosition(0), expected[kN - 1].GetPosition(0));
+  }
+}
@@ -60,9 +60,9 @@ TEST_F(OperationFixture, SetPositionIfUniqueWithUniquePositionsSucceed)
     EXPECT_TRUE(ops.SetPositionIfUnique(i));
   }
 
-  const auto& positions = ops.GetPositions();
+  EXPECT_EQ(ops.GetTargetNum(), kTargetNum);
   for (size_t i = 0; i < kTargetNum; ++i) {
-    EXPECT_EQ(positions.at(i), i);
+    EXPECT_EQ(ops.GetPosition(i), i);
   }
 }
 
@@ -76,6 +76,17 @@ TEST_F(OperationFixture, SetPositionIfUniqueWithDuplicatePositionsFail)
   }
 }
 
+TEST_F(OperationFixture, SetPositionIfUniqueWithTooManyPositionsThrowOutOfRange)
+{
+  Operation ops{};
+
+  for (size_t i = 0; i < kMaxTargetNum; ++i) {
+    ops.SetPositionIfUnique(i);
+  }
+  EXPECT_THROW(ops.SetPositionIfUnique(kMaxTargetNum), std::out_of_range);
+  EXPECT_EQ(ops.GetTargetNum(), kMaxTargetNum);
+}
+
 TEST_F(OperationFixture, SortTargetsWithUniquePositionsSortInAscendingOrder)
 {
   Operation ops{};
@@ -86,8 +97,65 @@ TEST_F(OperationFixture, SortTargetsWithUniquePositionsSortInAscendingOrder)
   }
   ops.SortTargets();
 
-  const auto& positions = ops.GetPositions();
+  EXPECT_EQ(ops.GetTargetNum(), kTargetNum);
+  for (size_t i = 0; i < kTargetNum; ++i) {
+    EXPECT_EQ(ops.GetPosition(i), i);
+  }
+}
+
+TEST_F(OperationFixture, ComputeNewValuesWithIncrementAddOneToAllTargets)
+{
+  Operation ops{};
+  uint64_t old_vals[kTargetNum];
+  uint64_t new_vals[kTargetNum];
+  for (size_t i = 0; i < kTargetNum; ++i) {
+    ops.SetPositionIfUnique(i);
+    old_vals[i] = i;
+  }
+  ops.SortTargets();
+
+  EXPECT_TRUE(ops.ComputeNewValues(old_vals, new_vals));
+  for (size_t i = 0; i < kTargetNum; ++i) {
+    EXPECT_EQ(new_vals[i], old_vals[i] + 1);
+  }
+}
+
+TEST_F(OperationFixture, ComputeNewValuesWithTransferKeepTotalBalance)
+{
+  constexpr uint64_t kAmount = 10;
+  constexpr uint64_t kBalance = 100;
+
+  Operation ops{};
+  uint64_t old_vals[kTargetNum];
+  uint64_t new_vals[kTargetNum];
+  for (int64_t i = kTargetNum - 1; i >= 0; --i) {
+    ops.SetPositionIfUnique(i);
+    old_vals[i] = kBalance;
+  }
+  ops.SetTransferAmount(kAmount);
+  ops.SortTargets();
+
+  EXPECT_TRUE(ops.ComputeNewValues(old_vals, new_vals));
+  uint64_t sum = 0;
   for (size_t i = 0; i < kTargetNum; ++i) {
-    EXPECT_EQ(positions.at(i), i);
+    sum += new_vals[i];
   }
+  EXPECT_EQ(sum, kBalance * kTargetNum);
+  EXPECT_EQ(new_vals[kTargetNum - 1], kBalance - kAmount * (kTargetNum - 1));
+}
+
+TEST_F(OperationFixture, ComputeNewValuesWithInsufficientBalanceFail)
+{
+  constexpr uint64_t kAmount = 10;
+
+  Operation ops{};
+  uint64_t old_vals[kTargetNum] = {};
+  uint64_t new_vals[kTargetNum];
+  for (size_t i = 0; i < kTargetNum; ++i) {
+    ops.SetPositionIfUnique(i);
+  }
+  ops.SetTransferAmount(kAmount);
+  ops.SortTargets();
+
+  EXPECT_FALSE(ops.ComputeNewValues(old_vals, new_vals));
 }
@@ -22,15 +22,21 @@
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
+#include <cstdlib>
 #include <filesystem>
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <type_traits>
 #include <vector>
 
+// system headers
+#include <sys/wait.h>
+#include <unistd.h>
+
 // external libraries
 #include "gtest/gtest.h"
 
@@ -49,6 +55,10 @@ constexpr size_t kArrayCapacity = PMWCAS_BENCH_MAX_TARGET_NUM;
 
 constexpr size_t kBlockSize = 256;
 
+constexpr size_t kWordsPerGroup = 4;
+
+constexpr size_t kSegmentSize = kBlockSize * 4;
+
 constexpr size_t kTestThreadNum = DBGROUP_TEST_THREAD_NUM;
 
 constexpr std::string_view kTmpPMEMPath = DBGROUP_ADD_QUOTES(DBGROUP_TEST_TMP_PMEM_PATH);
@@ -94,12 +104,7 @@ class PMwCASTargetFixture : public ::testing::Test
   void
   SetUp() override
   {
-    std::filesystem::path pool_path{kTmpPMEMPath};
-    pool_path /= use_name;
-    target_ = std::make_unique<PMwCASTarget_t>(pool_path, kArrayCapacity, kBlockSize);
-
-    ready_num_ = 0;
-    ready_for_testing_ = false;
+    PrepareTarget(1, 0);
   }
 
   void
@@ -113,20 +118,29 @@ class PMwCASTargetFixture : public ::testing::Test
    *##########################################################################*/
 
   void
-  RunPMwCAS(  //
-      const size_t thread_num,
-      const size_t target_num)
+  PrepareTarget(  //
+      const size_t words_per_group,
+      const size_t segment_size,
+      const ContentionPolicy policy = kNoBackoff)
   {
-    if constexpr (std::is_same_v<Competitor, PCAS>) {
-      if (target_num > 1) GTEST_SKIP();
-    }
+    std::filesystem::path pool_path{kTmpPMEMPath};
+    pool_path /= use_name;
+    target_ = nullptr;
+    target_ = std::make_unique<PMwCASTarget_t>(pool_path, kArrayCapacity, kBlockSize,
+                                               words_per_group, segment_size);
+    target_->SetContentionPolicy(policy);
 
-    Operation ops{};
-    for (size_t i = 0; i < target_num; ++i) {
-      ops.SetPositionIfUnique(i);
-    }
+    ready_num_ = 0;
+    ready_for_testing_ = false;
+  }
 
+  void
+  RunWorkers(  //
+      const size_t thread_num,
+      const std::vector<Operation> &ops)
+  {
     // create worker threads
+    std::atomic_size_t completed_num{0};
     std::vector<std::thread> threads{};
     for (size_t i = 0; i < thread_num; ++i) {
       threads.emplace_back([&]() {
@@ -135,9 +149,12 @@ class PMwCASTargetFixture : public ::testing::Test
           ++ready_num_;
           cond_.wait(lock, [this] { return ready_for_testing_; });
         }
+        size_t cnt = 0;
         for (size_t i = 0; i < kExecNum; ++i) {
-          target_->Execute(ops);
+          cnt += target_->Execute(ops[i % ops.size()]);
         }
+        target_->TearDownForWorker();
+        completed_num += cnt;
       });
     }
 
@@ -153,11 +170,151 @@ class PMwCASTargetFixture : public ::testing::Test
     // wait for all the workers to finish
     for (auto &&t : threads) t.join();
 
+    // operations in flight must be completed before workers finish their queues
+    EXPECT_EQ(completed_num, kExecNum * thread_num);
+  }
+
+  void
+  RunPMwCAS(  //
+      const size_t thread_num,
+      const size_t target_num)
+  {
+    if constexpr (std::is_same_v<Competitor, PCAS>) {
+      if (target_num > 1) GTEST_SKIP();
+    }
+
+    Operation ops{};
+    for (size_t i = 0; i < target_num; ++i) {
+      ops.SetPositionIfUnique(i);
+    }
+    RunWorkers(thread_num, {ops});
+
     // check validity
     for (size_t i = 0; i < target_num; ++i) {
       const auto v = target_->GetValue(i);
       EXPECT_EQ(kExecNum * thread_num, v);
     }
+    EXPECT_EQ(target_->GetExecNum(), kExecNum * thread_num);
+    EXPECT_EQ(target_->Sum(thread_num), kExecNum * thread_num * target_num);
+  }
+
+  void
+  RunPMwCASInProcesses(  //
+      const size_t process_num,
+      const size_t thread_num,
+      const size_t target_num)
+  {
+    if constexpr (std::is_same_v<Competitor, PCAS>) {
+      if (target_num > 1) GTEST_SKIP();
+    }
+#ifndef PMWCAS_BENCH_DIRTY_VARIANT
+    if constexpr (std::is_same_v<Competitor, MicrosoftPMwCAS>) {
+      EXPECT_THROW(target_->PrepareProcesses(process_num), std::runtime_error);
+      return;
+    }
+#endif
+
+    Operation ops{};
+    for (size_t i = 0; i < target_num; ++i) {
+      ops.SetPositionIfUnique(i);
+    }
+    target_->PrepareProcesses(process_num);
+    std::vector<pid_t> pids{};
+    for (size_t i = 0; i < process_num; ++i) {
+      const auto pid = fork();
+      ASSERT_GE(pid, 0);
+      if (pid == 0) {
+        target_->AttachProcess(i);
+        RunWorkers(thread_num, {ops});
+        std::_Exit(::testing::Test::HasFailure() ? 1 : 0);
+      }
+      pids.emplace_back(pid);
+    }
+    for (const auto pid : pids) {
+      int status{};
+      waitpid(pid, &status, 0);
+      EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    // check validity with the mappings of this process
+    for (size_t i = 0; i < target_num; ++i) {
+      EXPECT_EQ(target_->GetValue(i), kExecNum * thread_num * process_num);
+    }
+  }
+
+  void
+  RunPMwCASWithValueMode(  //
+      const ValueMode mode,
+      const size_t thread_num,
+      const size_t target_num)
+  {
+    const auto node_num = PMwCASTarget_t::GetNodeNum(thread_num, kExecNum, target_num);
+    if (mode == kRandomValue && (kReservedBits<Competitor> & kRandomValueMask) != 0) {
+      // competitors must reject values that they cannot store
+      EXPECT_THROW(target_->SetValueMode(mode, node_num), std::runtime_error);
+      return;
+    }
+    target_->SetValueMode(mode, node_num);
+    RunPMwCAS(thread_num, target_num);
+  }
+
+  void
+  RunTransfer(  //
+      const size_t thread_num,
+      const size_t target_num)
+  {
+    if constexpr (std::is_same_v<Competitor, PCAS>) {
+      GTEST_SKIP();
+    }
+
+    Operation ops{};
+    for (size_t i = 0; i < target_num; ++i) {
+      ops.SetPositionIfUnique(i);
+    }
+    ops.SetTransferAmount(1);
+    ops.SortTargets();
+    target_->Fill(kInitialBalance, thread_num);
+    RunWorkers(thread_num, {ops});
+
+    // check validity
+    EXPECT_EQ(target_->Sum(thread_num), kInitialBalance * kArrayCapacity);
+    const auto moved = kExecNum * thread_num * (target_num - 1);
+    EXPECT_EQ(target_->GetValue(0), kInitialBalance - moved);
+  }
+
+  void
+  RunMixed(  //
+      const size_t thread_num,
+      const size_t target_num)
+  {
+    if constexpr (std::is_same_v<Competitor, PCAS>) {
+      GTEST_SKIP();
+    }
+
+    // alternate a PMwCAS on all the targets and a PCAS on the first one
+    Operation pmwcas_ops{};
+    for (size_t i = 0; i < target_num; ++i) {
+      pmwcas_ops.SetPositionIfUnique(i);
+    }
+    Operation pcas_ops{};
+    pcas_ops.SetPositionIfUnique(0);
+    pcas_ops.SetPCAS();
+    target_->EnableOpTypeLatency();
+    RunWorkers(thread_num, {pmwcas_ops, pcas_ops});
+
+    // check validity
+    const auto half = kExecNum / 2 * thread_num;
+    EXPECT_EQ(target_->GetValue(0), kExecNum * thread_num);
+    for (size_t i = 1; i < target_num; ++i) {
+      EXPECT_EQ(target_->GetValue(i), half);
+    }
+    const auto &stats = target_->GetOpTypeStats();
+    EXPECT_EQ(stats.pcas_num, half);
+    EXPECT_EQ(stats.pmwcas_num, half);
+    EXPECT_GT(stats.pcas_ns, 0);
+    EXPECT_GT(stats.pmwcas_ns, 0);
+    EXPECT_EQ(stats.pcas_hist.GetCount(), half);
+    EXPECT_EQ(stats.pmwcas_hist.GetCount(), half);
   }
 
   /*############################################################################
@@ -179,7 +336,12 @@ class PMwCASTargetFixture : public ::testing::Test
  * Preparation for typed testing
  *############################################################################*/
 
-using TestTargets = ::testing::Types<PMwCAS, MicrosoftPMwCAS, PCAS>;
+#ifdef PMWCAS_BENCH_DIRTY_VARIANT
+// our PMwCAS with dirty flags (see test/CMakeLists.txt)
+using TestTargets = ::testing::Types<PMwCAS>;
+#else
+using TestTargets = ::testing::Types<PMwCAS, MicrosoftPMwCAS, PCAS, LockMwCAS>;
+#endif
 TYPED_TEST_SUITE(PMwCASTargetFixture, TestTargets);
 
 /*------------------------------------------------------------------------------
@@ -205,3 +367,156 @@ TYPED_TEST(PMwCASTargetFixture, P3wCASWithMultiThreads)
 {  //
   TestFixture::RunPMwCAS(kTestThreadNum, 3);
 }
+
+TYPED_TEST(PMwCASTargetFixture, P3wCASWithCoLocatedWordsAndMultiThreads)
+{
+  TestFixture::PrepareTarget(kWordsPerGroup, 0);
+  TestFixture::RunPMwCAS(kTestThreadNum, 3);
+}
+
+TYPED_TEST(PMwCASTargetFixture, PMwCASWithSegmentedArrayAndMultiThreads)
+{
+  TestFixture::PrepareTarget(1, kSegmentSize);
+  TestFixture::RunPMwCAS(kTestThreadNum, kArrayCapacity);
+}
+
+TYPED_TEST(PMwCASTargetFixture, TransferWithMultiThreadsKeepTotalBalance)
+{  //
+  TestFixture::RunTransfer(kTestThreadNum, 3);
+}
+
+TYPED_TEST(PMwCASTargetFixture, P3wCASWithMultiProcessesShareArrayAndDescriptors)
+{
+  TestFixture::RunPMwCASInProcesses(2, kTestThreadNum, 3);
+}
+
+TYPED_TEST(PMwCASTargetFixture, P3wCASWithContentionManagersAndMultiThreads)
+{
+  for (const auto policy : {kExponentialBackoff, kRandomizedBackoff, kAdaptiveBackoff}) {
+    TestFixture::PrepareTarget(1, 0, policy);
+    TestFixture::RunPMwCAS(kTestThreadNum, 3);
+  }
+}
+
+TYPED_TEST(PMwCASTargetFixture, MixedPCASAndP3wCASWithMultiThreads)
+{  //
+  TestFixture::RunMixed(kTestThreadNum, 3);
+}
+
+TYPED_TEST(PMwCASTargetFixture, P3wCASWithFixedTargetNumAndMultiThreads)
+{
+  TestFixture::target_->SetFixedTargetNum(3);
+  TestFixture::RunPMwCAS(kTestThreadNum, 3);
+}
+
+TYPED_TEST(PMwCASTargetFixture, MixedPCASAndP3wCASWithFixedTargetNumAndMultiThreads)
+{
+  TestFixture::target_->SetFixedTargetNum(3);
+  TestFixture::RunMixed(kTestThreadNum, 3);
+}
+
+TYPED_TEST(PMwCASTargetFixture, P3wCASWithInterleavingAndMultiThreads)
+{
+  TestFixture::target_->SetInterleaveWidth(4, kExecNum);
+  TestFixture::RunPMwCAS(kTestThreadNum, 3);
+}
+
+TYPED_TEST(PMwCASTargetFixture, P3wCASWithInterleavingAndFixedTargetNumAndBackoff)
+{
+  TestFixture::PrepareTarget(1, 0, kExponentialBackoff);
+  TestFixture::target_->SetFixedTargetNum(3);
+  TestFixture::target_->SetInterleaveWidth(4, kExecNum);
+  TestFixture::RunPMwCAS(kTestThreadNum, 3);
+}
+
+TYPED_TEST(PMwCASTargetFixture, MixedPCASAndP3wCASWithInterleavingAndMultiThreads)
+{
+  TestFixture::target_->SetInterleaveWidth(4, kExecNum);
+  TestFixture::RunMixed(kTestThreadNum, 3);
+}
+
+TYPED_TEST(PMwCASTargetFixture, P3wCASWithPrefetchingAndMultiThreads)
+{
+  // every worker follows the same queue and prefetches its targets ahead
+  Operation ops{};
+  for (size_t i = 0; i < 3; ++i) {
+    ops.SetPositionIfUnique(i);
+  }
+  TestFixture::target_->SetPrefetchQueues({std::vector<Operation>(kExecNum, ops)}, 8);
+  TestFixture::RunPMwCAS(kTestThreadNum, 3);
+}
+
+TYPED_TEST(PMwCASTargetFixture, P3wCASWithPreemptionAndMultiThreads)
+{
+  TestFixture::target_->SetPreemption(100, 0);
+  TestFixture::RunPMwCAS(kTestThreadNum, 3);
+}
+
+TYPED_TEST(PMwCASTargetFixture, P3wCASWithContentionBreakdownCountAllOperations)
+{
+  TestFixture::target_->EnableContentionBreakdown();
+  TestFixture::RunPMwCAS(kTestThreadNum, 3);
+
+  size_t cnt = 0;
+  for (const auto &hist : TestFixture::target_->GetContentionHistograms()) {
+    cnt += hist.GetCount();
+  }
+  EXPECT_EQ(cnt, TestFixture::target_->GetExecNum());
+}
+
+TYPED_TEST(PMwCASTargetFixture, P3wCASWithTSCLatencyCountAllOperations)
+{
+  TestFixture::target_->EnableTSCLatency();
+  TestFixture::RunPMwCAS(kTestThreadNum, 3);
+
+  const auto &hist = TestFixture::target_->GetTSCLatencyHistogram();
+  EXPECT_EQ(hist.GetCount(), TestFixture::target_->GetExecNum());
+}
+
+TYPED_TEST(PMwCASTargetFixture, P3wCASWithBatchedEpochsAndMultiThreads)
+{
+  TestFixture::target_->SetEpochScope(16);
+  TestFixture::target_->EnableEpochLag();
+  TestFixture::RunPMwCAS(kTestThreadNum, 3);
+}
+
+TYPED_TEST(PMwCASTargetFixture, P3wCASWithEpochPerWorkerAndMultiThreads)
+{
+  TestFixture::target_->SetEpochScope(0);
+  TestFixture::RunPMwCAS(kTestThreadNum, 3);
+}
+
+TYPED_TEST(PMwCASTargetFixture, P3wCASWithMultiThreadsCountConflictsAtMostExecNum)
+{
+  TestFixture::RunPMwCAS(kTestThreadNum, 3);
+
+  EXPECT_LE(TestFixture::target_->GetConflictNum(), TestFixture::target_->GetExecNum());
+}
+
+TYPED_TEST(PMwCASTargetFixture, P3wCASWithPointerValuesAndMultiThreads)
+{  //
+  TestFixture::RunPMwCASWithValueMode(kPointerValue, kTestThreadNum, 3);
+}
+
+TYPED_TEST(PMwCASTargetFixture, P3wCASWithRandomValuesAndMultiThreads)
+{  //
+  TestFixture::RunPMwCASWithValueMode(kRandomValue, kTestThreadNum, 3);
+}
+
+TYPED_TEST(PMwCASTargetFixture, P3wCASWithReservedBitValuesAndMultiThreads)
+{  //
+  TestFixture::RunPMwCASWithValueMode(kReservedValue, kTestThreadNum, 3);
+}
+
+TYPED_TEST(PMwCASTargetFixture, P3wCASWithPointerValuesAndInterleavingAndMultiThreads)
+{
+  TestFixture::target_->SetInterleaveWidth(4, kExecNum);
+  TestFixture::RunPMwCASWithValueMode(kPointerValue, kTestThreadNum, 3);
+}
+
+TYPED_TEST(PMwCASTargetFixture, TransferWithPointerValuesKeepTotalBalance)
+{
+  const auto node_num = PMwCASTarget<TypeParam>::GetNodeNum(kTestThreadNum, kExecNum, 3);
+  TestFixture::target_->SetValueMode(kPointerValue, node_num);
+  TestFixture::RunTransfer(kTestThreadNum, 3);
+}
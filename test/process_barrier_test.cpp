@@ -0,0 +1,92 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "process_barrier.hpp"
+
+// C++ standard libraries
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+
+// system headers
+#include <sys/wait.h>
+#include <unistd.h>
+
+// external libraries
+#include "gtest/gtest.h"
+
+class ProcessBarrierFixture : public ::testing::Test
+{
+ protected:
+  /*############################################################################
+   * Internal classes
+   *##########################################################################*/
+
+  struct alignas(kCacheLineSize) Result {
+    size_t process_id{0};
+  };
+
+  /*############################################################################
+   * Constants
+   *##########################################################################*/
+
+  static constexpr size_t kProcessNum = 4;
+
+  /*############################################################################
+   * Setup/Teardown
+   *##########################################################################*/
+
+  void
+  SetUp() override
+  {
+  }
+
+  void
+  TearDown() override
+  {
+  }
+};
+
+/*------------------------------------------------------------------------------
+ * Test definitions
+ *----------------------------------------------------------------------------*/
+
+TEST_F(ProcessBarrierFixture, WaitWithChildProcessesShareResults)
+{
+  ProcessBarrier<Result> barrier{kProcessNum, kProcessNum};
+
+  std::vector<pid_t> pids{};
+  for (size_t i = 0; i < kProcessNum; ++i) {
+    const auto pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      barrier.Wait();
+      barrier.GetResult(i).process_id = i + 1;
+      std::_Exit(0);
+    }
+    pids.emplace_back(pid);
+  }
+  for (const auto pid : pids) {
+    int status{};
+    waitpid(pid, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status));
+  }
+
+  for (size_t i = 0; i < kProcessNum; ++i) {
+    EXPECT_EQ(barrier.GetResult(i).process_id, i + 1);
+  }
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "queue_target.hpp"
+
+// C++ standard libraries
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// external libraries
+#include "gtest/gtest.h"
+
+// local sources
+#include "competitor.hpp"
+#include "queue_operation_engine.hpp"
+
+// macros for modifying input strings
+#define DBGROUP_ADD_QUOTES_INNER(x) #x                     // NOLINT
+#define DBGROUP_ADD_QUOTES(x) DBGROUP_ADD_QUOTES_INNER(x)  // NOLINT
+
+/*##############################################################################
+ * Global contants
+ *############################################################################*/
+
+constexpr size_t kTestThreadNum = DBGROUP_TEST_THREAD_NUM;
+
+constexpr std::string_view kTmpPMEMPath = DBGROUP_ADD_QUOTES(DBGROUP_TEST_TMP_PMEM_PATH);
+
+constexpr size_t kExecNum = 1E4;
+
+constexpr size_t kCapacity = 1024;
+
+const std::string_view use_name = std::getenv("USER");
+
+/*##############################################################################
+ * Fixture definitions
+ *############################################################################*/
+
+template <class Competitor>
+class QueueTargetFixture : public ::testing::Test
+{
+ protected:
+  /*############################################################################
+   * Setup/Teardown
+   *##########################################################################*/
+
+  void
+  SetUp() override
+  {
+    if (kTmpPMEMPath.empty() || !std::filesystem::exists(kTmpPMEMPath)) {
+      std::cerr << "WARN: The correct path to persistent memory is not set." << std::endl;
+      GTEST_SKIP();
+    }
+  }
+
+  void
+  TearDown() override
+  {
+  }
+
+  /*############################################################################
+   * Utilities
+   *##########################################################################*/
+
+  void
+  RunQueue(  //
+      const size_t producer_num,
+      const size_t prefill_num)
+  {
+    std::filesystem::path pool_path{kTmpPMEMPath};
+    pool_path /= use_name;
+
+    QueueTarget<Competitor> target{pool_path, kCapacity, prefill_num};
+    QueueOperationEngine ops_engine{producer_num};
+
+    std::atomic_size_t done_num{0};
+    std::vector<std::thread> threads{};
+    for (size_t i = 0; i < kTestThreadNum; ++i) {
+      const auto &operations = ops_engine.Generate(kExecNum, i);
+      threads.emplace_back([&, operations]() {
+        size_t local_num = 0;
+        target.SetUpForWorker();
+        for (const auto &ops : operations) {
+          local_num += target.Execute(ops);
+        }
+        target.TearDownForWorker();
+        done_num += local_num;
+      });
+    }
+    for (auto &&t : threads) t.join();
+
+    const auto &stats = target.GetStats();
+    EXPECT_EQ(stats.enqueue_num + stats.dequeue_num + stats.full_num + stats.empty_num,
+              kExecNum * kTestThreadNum);
+    EXPECT_EQ(done_num.load(), stats.enqueue_num + stats.dequeue_num);
+    EXPECT_TRUE(target.Verify());
+  }
+};
+
+/*##############################################################################
+ * Preparation for typed testing
+ *############################################################################*/
+
+using Competitors = ::testing::Types<PMwCAS, MicrosoftPMwCAS, LockMwCAS>;
+TYPED_TEST_SUITE(QueueTargetFixture, Competitors);
+
+/*##############################################################################
+ * Unit test definitions
+ *############################################################################*/
+
+TYPED_TEST(QueueTargetFixture, EnqueueAndDequeueInTurnWithMultiThreads)
+{  //
+  TestFixture::RunQueue(0, 0);
+}
+
+TYPED_TEST(QueueTargetFixture, ProducersAndConsumersWithMultiThreads)
+{  //
+  TestFixture::RunQueue(kTestThreadNum / 2, kCapacity / 2);
+}
+
+TYPED_TEST(QueueTargetFixture, ProducersOnlyWithMultiThreadsFillQueue)
+{  //
+  TestFixture::RunQueue(kTestThreadNum, 0);
+}
+
+TYPED_TEST(QueueTargetFixture, EnqueueAndDequeueInTurnOnFullQueue)
+{  //
+  TestFixture::RunQueue(0, kCapacity);
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "sample_stats.hpp"
+
+// C++ standard libraries
+#include <cmath>
+#include <cstddef>
+
+// external libraries
+#include "gtest/gtest.h"
+
+class SampleStatsFixture : public ::testing::Test
+{
+ protected:
+  /*############################################################################
+   * Constants
+   *##########################################################################*/
+
+  static constexpr double kEpsilon = 1e-9;
+
+  /*############################################################################
+   * Setup/Teardown
+   *##########################################################################*/
+
+  void
+  SetUp() override
+  {
+  }
+
+  void
+  TearDown() override
+  {
+  }
+};
+
+/*------------------------------------------------------------------------------
+ * Test definitions
+ *----------------------------------------------------------------------------*/
+
+TEST_F(SampleStatsFixture, EmptyStatsReturnZero)
+{
+  const SampleStats stats{};
+  EXPECT_EQ(stats.GetCount(), 0);
+  EXPECT_EQ(stats.GetMean(), 0);
+  EXPECT_EQ(stats.GetStdDev(), 0);
+  EXPECT_EQ(stats.GetMedian(), 0);
+  EXPECT_EQ(stats.GetCIHalfWidth(), 0);
+}
+
+TEST_F(SampleStatsFixture, SummaryOfKnownSamplesMatchReferenceValues)
+{
+  SampleStats stats{};
+  for (const auto val : {4.0, 2.0, 8.0, 6.0}) {
+    stats.Add(val);
+  }
+
+  const auto stddev = std::sqrt(20.0 / 3);
+  EXPECT_EQ(stats.GetCount(), 4);
+  EXPECT_NEAR(stats.GetMean(), 5.0, kEpsilon);
+  EXPECT_NEAR(stats.GetStdDev(), stddev, kEpsilon);
+  EXPECT_NEAR(stats.GetMedian(), 5.0, kEpsilon);
+  EXPECT_NEAR(stats.GetCIHalfWidth(), 3.182 * stddev / 2, kEpsilon);
+  EXPECT_NEAR(stats.GetRelativeCI(), 3.182 * stddev / 2 / 5.0, kEpsilon);
+
+  stats.Add(100.0);
+  EXPECT_NEAR(stats.GetMedian(), 6.0, kEpsilon);
+}
+
+TEST_F(SampleStatsFixture, GetTValueApproachNormalDistribution)
+{
+  EXPECT_EQ(SampleStats::GetTValue(0), 0);
+  for (size_t df = 1; df < 1000; ++df) {
+    EXPECT_GE(SampleStats::GetTValue(df), SampleStats::GetTValue(df + 1));
+  }
+  EXPECT_NEAR(SampleStats::GetTValue(40), 2.021, kEpsilon);
+  EXPECT_NEAR(SampleStats::GetTValue(50), 2.009, 1E-3);
+  EXPECT_NEAR(SampleStats::GetTValue(60), 2.000, kEpsilon);
+  EXPECT_NEAR(SampleStats::GetTValue(120), 1.980, kEpsilon);
+  EXPECT_NEAR(SampleStats::GetTValue(1000), 1.962, 1E-3);
+}
+
+TEST_F(SampleStatsFixture, DiffersSignificantlyDetectSeparatedMeans)
+{
+  SampleStats base{};
+  SampleStats same{};
+  SampleStats slow{};
+  for (const auto val : {100.0, 102.0, 98.0, 101.0, 99.0}) {
+    base.Add(val);
+    same.Add(val + 1);
+    slow.Add(val * 0.8);
+  }
+
+  EXPECT_FALSE(SampleStats::DiffersSignificantly(base, base));
+  EXPECT_FALSE(SampleStats::DiffersSignificantly(base, same));
+  EXPECT_TRUE(SampleStats::DiffersSignificantly(base, slow));
+  EXPECT_TRUE(SampleStats::DiffersSignificantly(slow, base));
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "tsc_clock.hpp"
+
+// C++ standard libraries
+#include <chrono>
+#include <cstdint>
+
+// external libraries
+#include "gtest/gtest.h"
+
+class TSCClockFixture : public ::testing::Test
+{
+ protected:
+  /*############################################################################
+   * Constants
+   *##########################################################################*/
+
+  static constexpr auto kCalibration = std::chrono::milliseconds{10};
+
+  static constexpr auto kSpin = std::chrono::milliseconds{20};
+
+  /*############################################################################
+   * Setup/Teardown
+   *##########################################################################*/
+
+  void
+  SetUp() override
+  {
+    if (!TSCClock::IsInvariant()) {
+      GTEST_SKIP() << "This processor does not have an invariant TSC.";
+    }
+  }
+
+  void
+  TearDown() override
+  {
+  }
+};
+
+/*------------------------------------------------------------------------------
+ * Test definitions
+ *----------------------------------------------------------------------------*/
+
+TEST_F(TSCClockFixture, NowNeverGoBackward)
+{
+  auto prev = TSCClock::Now();
+  for (size_t i = 0; i < 100000; ++i) {
+    const auto now = TSCClock::Now();
+    EXPECT_GE(now, prev);
+    prev = now;
+  }
+}
+
+TEST_F(TSCClockFixture, ToNanosMatchSteadyClock)
+{
+  using Clock_t = std::chrono::steady_clock;
+
+  const TSCClock clock{kCalibration};
+  EXPECT_GT(clock.GetCyclesPerNano(), 0);
+
+  const auto &begin = Clock_t::now();
+  const auto begin_cycles = TSCClock::Now();
+  while (Clock_t::now() - begin < kSpin) {
+    // spin
+  }
+  const auto elapsed = clock.ToNanos(TSCClock::Now() - begin_cycles);
+  const auto expected = std::chrono::duration_cast<std::chrono::nanoseconds>(kSpin).count();
+
+  EXPECT_GE(elapsed, expected * 0.9);
+  EXPECT_LE(elapsed, expected * 1.5);
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "value_codec.hpp"
+
+// C++ standard libraries
+#include <cstddef>
+#include <cstdint>
+
+// external libraries
+#include "gtest/gtest.h"
+
+class ValueCodecFixture : public ::testing::Test
+{
+ protected:
+  /*############################################################################
+   * Constants
+   *##########################################################################*/
+
+  static constexpr size_t kN = 100000;
+
+  /*############################################################################
+   * Setup/Teardown
+   *##########################################################################*/
+
+  void
+  SetUp() override
+  {
+  }
+
+  void
+  TearDown() override
+  {
+  }
+};
+
+/*------------------------------------------------------------------------------
+ * Test definitions
+ *----------------------------------------------------------------------------*/
+
+TEST_F(ValueCodecFixture, RandomValuesAreDecodedIntoOriginalCounters)
+{
+  EXPECT_EQ(EncodeRandomValue(0), 0);
+  for (uint64_t cnt = 0; cnt < kN; ++cnt) {
+    EXPECT_EQ(DecodeRandomValue(EncodeRandomValue(cnt)), cnt);
+  }
+  for (const auto cnt : {1UL << 32UL, kRandomValueMask}) {
+    EXPECT_EQ(DecodeRandomValue(EncodeRandomValue(cnt)), cnt);
+  }
+}
+
+TEST_F(ValueCodecFixture, RandomValuesUseAll62Bits)
+{
+  uint64_t ored = 0;
+  size_t high_num = 0;
+  for (uint64_t cnt = 1; cnt <= kN; ++cnt) {
+    const auto val = EncodeRandomValue(cnt);
+    ASSERT_EQ(val & ~kRandomValueMask, 0);
+    ored |= val;
+    if (val >> (kRandomValueBits - 1)) ++high_num;
+  }
+  EXPECT_EQ(ored, kRandomValueMask);
+  EXPECT_GT(high_num, kN / 4);
+  EXPECT_LT(high_num, kN * 3 / 4);
+}
+
+TEST_F(ValueCodecFixture, ReservedPatternsUseHighestFreeBits)
+{
+  EXPECT_EQ(GetReservedPattern(0), 0b11UL << 62UL);
+  EXPECT_EQ(GetReservedPattern(1UL << 63UL), 0b11UL << 61UL);
+  EXPECT_EQ(GetReservedPattern(0b11UL << 62UL), 0b11UL << 60UL);
+  EXPECT_EQ(GetReservedPattern(0b111UL << 61UL), 0b11UL << 59UL);
+}